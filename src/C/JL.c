@@ -10,14 +10,16 @@
 static inline jl_t* jl_init_essential__(void) {
 	// Memory
 	jvct_t* _jl = jl_mem_init__(); // Create The Library Context
+	// Thread contexts ( printing uses the main thread's )
+	jl_thread_init__(_jl->jl);
 	// Printing to terminal
 	jl_print_init__(_jl->jl);
 	return _jl->jl;
 }
 
 static inline void jl_init_libs__(jl_t* jl) {
-	JL_PRINT_DEBUG(jl, "Initializing threads....");
-	jl_thread_init__(jl);
+	JL_PRINT_DEBUG(jl, "Initializing jobs....");
+	jl_job_init__(jl);
 	JL_PRINT_DEBUG(jl, "Initializing file system....");
 	jl_file_init__(jl->_jl);
 	JL_PRINT_DEBUG(jl, "Initializing modes....");
@@ -37,6 +39,9 @@ static inline void jl_init__(jl_t* jl,jl_fnct _fnc_init_,str_t nm,u64_t ctx1s) {
 	jl->name = jl_mem_copy(jl, nm, strlen(nm));
 	// Run the program's init function.
 	_fnc_init_(jl);
+	// Keep the main thread off the other threads' CPUs.  Not until now, so
+	// threads SDL made during init don't start on just main's CPU.
+	jl_thread_pin(jl, jl_thread_cpus(jl, JL_THREAD_MAIN));
 	jl_print(jl, "Started JL_Lib!");
 }
 
@@ -63,12 +68,18 @@ static inline void jl_seconds_passed__(jl_t* jl) {
 }
 
 static inline void main_loop__(jl_t* jl) {
-	jl_fnct loop_ = jl->mode.mode.loop;
-
 	// Check the amount of time passed since last frame.
 	jl_seconds_passed__(jl);
-	// Run the user's mode loop.
-	loop_(jl);
+	// Run continuations of async work that finished since last frame.
+	jl_async_update__(jl);
+	// Run the user's mode loop ( or the rest of a yielding mode init ).
+	jl_mode_loop__(jl);
+	// Release the main thread's scratch memory for this frame.
+	jl_mem_frame_reset(jl);
+	// Shed caches if memory use went over the soft budget.
+	jl_mem_pressure__(jl);
+	// Count the frame for the allocation profiler.
+	jl_mem_profile_frame__();
 }
 
 static inline int jl_kill__(jl_t* jl, int rc) {
@@ -84,9 +95,18 @@ static inline int jl_kill__(jl_t* jl, int rc) {
 	}
 	// Set status to Exiting
 	_jl->me.status = JL_STATUS_EXIT;
+	jl_job_kill__(jl);
+	jl_async_kill__(jl);
 	jl_file_kill__(_jl);
+#ifdef JL_MEM_PROFILE
+	jl_mem_profile_print(jl);
+#endif
+#ifdef JL_THREAD_PROFILE
+	jl_thread_profile_print(jl);
+#endif
 	jl_print_kill__(jl);
 	JL_PRINT("PRINTG KILL'd\n");
+	jl_thread_kill__(jl);
 	jl_mem_kill__(_jl);
 	JL_PRINT("PRINTG KILL'd\n");
 	JL_PRINT("[\\JL_Lib] ");
@@ -0,0 +1,168 @@
+/*
+ * JL_Lib
+ * Copyright (c) 2015 Jeron A. Lau
+*/
+/** \file
+ * JLasync.c
+ *	Futures: a function run on a job worker, with a result that's picked up
+ *	later.  The result is either waited for, or handed to a continuation
+ *	that runs on the main thread at the start of the next frame, so the
+ *	program never needs a lock to use it.
+**/
+#include "jl_pr.h"
+
+enum {
+	JL_FUTURE_PENDING,	// Running, nothing attached.
+	JL_FUTURE_THEN,		// Running, a continuation is attached.
+	JL_FUTURE_DONE,		// Finished, nothing attached.
+};
+
+struct jl_future_s{
+	jl_async_fnt fn;	// The function to run.
+	void* arg;		// Passed to "fn".
+	void* result;		// What "fn" returned.
+	SDL_atomic_t state;	// JL_FUTURE_*
+	jl_future_fnt then;	// The continuation ( main thread ).
+	void* data;		// Passed to "then".
+	jl_future_t* next;	// Next in the list of finished futures.
+};
+
+static struct {
+	// Futures with continuations that finished ( newest first ).
+	void* finished;
+}jl_async__;
+
+//
+// Internal Functions
+//
+
+// Add to the list of finished futures ( any thread ).
+static void jl_async_push__(jl_future_t* future) {
+	void* head;
+
+	do {
+		head = SDL_AtomicGetPtr(&jl_async__.finished);
+		future->next = head;
+	} while(!SDL_AtomicCASPtr(&jl_async__.finished, head, future));
+}
+
+static void jl_async_run__(jl_t* jl, void* data) {
+	jl_future_t* future = data;
+
+	future->result = future->fn(jl, future->arg);
+	// If a continuation was attached, the main thread takes it from here.
+	if(!SDL_AtomicCAS(&future->state, JL_FUTURE_PENDING, JL_FUTURE_DONE))
+		jl_async_push__(future);
+}
+
+// Take the list of finished futures, oldest first.
+static jl_future_t* jl_async_take__(void) {
+	jl_future_t* future = SDL_AtomicSetPtr(&jl_async__.finished, NULL);
+	jl_future_t* oldest = NULL;
+
+	while(future) {
+		jl_future_t* next = future->next;
+
+		future->next = oldest;
+		oldest = future;
+		future = next;
+	}
+	return oldest;
+}
+
+//
+// Exported Functions
+//
+
+/**
+ * Run a function on a job worker, without waiting for it.
+ * @param jl: The library context.
+ * @param fn: The function to run.
+ * @param arg: Passed to "fn".
+ * @returns: The future for "fn"'s result.  Pass it to jl_future_wait() or
+ *	jl_future_then() ( not both ), which free it.
+**/
+jl_future_t* jl_async(jl_t* jl, jl_async_fnt fn, void* arg) {
+	jl_future_t* future = jl_memi(jl, sizeof(jl_future_t));
+
+	future->fn = fn;
+	future->arg = arg;
+	SDL_AtomicSet(&future->state, JL_FUTURE_PENDING);
+	jl_job_run(jl, jl_async_run__, future, NULL);
+	return future;
+}
+
+/**
+ * Check if a future's function has finished, without waiting.
+ * @param future: The future from jl_async().
+ * @returns: 1 if finished, 0 if not.
+**/
+u8_t jl_future_poll(jl_future_t* future) {
+	return SDL_AtomicGet(&future->state) == JL_FUTURE_DONE;
+}
+
+/**
+ * Wait for a future's function to finish, running other jobs meanwhile.
+ * @param jl: The library context.
+ * @param future: The future from jl_async() ( freed ).
+ * @returns: What the function returned.
+**/
+void* jl_future_wait(jl_t* jl, jl_future_t* future) {
+	void* result;
+
+	while(!jl_future_poll(future)) {
+		// The function is running on another thread.
+		if(!jl_job_help__(jl))
+			jl_job_nap__(jl, &future->state, JL_FUTURE_DONE);
+	}
+	result = future->result;
+	jl_mem(jl, future, 0);
+	return result;
+}
+
+/**
+ * Run a function on the main thread, at the start of the first frame after a
+ * future's function finishes.
+ * @param jl: The library context.
+ * @param future: The future from jl_async() ( freed after "fn" runs ).
+ * @param fn: The continuation, which gets the result.
+ * @param data: Passed to "fn".
+**/
+void jl_future_then(jl_t* jl, jl_future_t* future, jl_future_fnt fn,
+	void* data)
+{
+	future->then = fn;
+	future->data = data;
+	// Already finished: hand it to the main thread now.
+	if(!SDL_AtomicCAS(&future->state, JL_FUTURE_PENDING, JL_FUTURE_THEN))
+		jl_async_push__(future);
+}
+
+//
+// Internal functions
+//
+
+// Run continuations of finished futures ( main thread, each frame ).
+void jl_async_update__(jl_t* jl) {
+	jl_future_t* future = jl_async_take__();
+
+	while(future) {
+		jl_future_t* next = future->next;
+
+		future->then(jl, future->result, future->data);
+		jl_mem(jl, future, 0);
+		future = next;
+	}
+}
+
+// Free futures that finished after the last frame, without continuing them.
+void jl_async_kill__(jl_t* jl) {
+	jl_future_t* future = jl_async_take__();
+
+	while(future) {
+		jl_future_t* next = future->next;
+
+		jl_mem(jl, future, 0);
+		future = next;
+	}
+}
@@ -12,57 +12,29 @@
 */
 #include "jl_pr.h"
 
-static inline void *_jl_cl_list_alphabetize_lowest(struct cl_list *list) {
-	int i, j, k;
-	char *rtn = NULL;
-	//Allocate and clear checked
-	uint8_t *notchecked = malloc(sizeof(uint8_t) * cl_list_count(list));
-	for(i = 0; i < cl_list_count(list); i++) notchecked[i] = 1;
-	j = 0;
-	while(1) {
-		uint8_t ckv = 255;
-		uint8_t count = 0;
-		struct cl_list_iterator *iterator = cl_list_iterator_create(list);
-		for(i = 0; i < cl_list_count(list); i++) {
-			char *s = cl_list_iterator_next(iterator);
-			if(notchecked[i]) {
-				if(s[j] > ckv) {
-					notchecked[i] = 0; //check & cancel
-				}else if(s[j] == ckv) {
-					count++;
-				}else if(s[j] < ckv) {
-					//Invalidate everything that came before
-					//Because this is more that all that.
-					for(k = 0; k < i; k++)
-						notchecked[k] = 0;
-					ckv = s[j];
-					count = 1;
-					rtn = s;
-				}
-			}
-		}
-		cl_list_iterator_destroy(iterator);
-		if(count == 1) break;
-		else j++;
-	}
-	free(notchecked);
-	return rtn;
+static int jl_cl_list_alphabetize_cmp__(const void* a, const void* b) {
+	return strcmp(*(char* const*)a, *(char* const*)b);
 }
 
-void jl_cl_list_alphabetize(struct cl_list *list) {
-	int i;
+/**
+ * Sort a list of strings alphabetically.
+ * @param jl: The library context.
+ * @param list: The list to sort ( the strings aren't copied ).
+**/
+void jl_cl_list_alphabetize(jl_t* jl, struct cl_list *list) {
+	u32_t count = cl_list_count(list);
+	char** strings;
+	m_u32_t i;
 
-	struct cl_list *alphabetized = cl_list_create();
-	while(!cl_list_is_empty(list)) {
-		void *l = _jl_cl_list_alphabetize_lowest(list);
-		cl_list_remove(list, l);
-		cl_list_add_tail(alphabetized, l);
-	}
+	if(count < 2) return;
+	// Copy the list into an array, sort it, then put it back in order.
+	strings = jl_mem(jl, NULL, count * sizeof(char*));
+	struct cl_list_iterator *iterator = cl_list_iterator_create(list);
+	for(i = 0; i < count; i++) strings[i] = cl_list_iterator_next(iterator);
+	cl_list_iterator_destroy(iterator);
+	jl_par_sort(jl, strings, count, sizeof(char*),
+		jl_cl_list_alphabetize_cmp__);
 	cl_list_clear(list);
-	struct cl_list_iterator *iterator =
-		cl_list_iterator_create(alphabetized);
-	for(i = 0; i < cl_list_count(alphabetized); i++) {
-		cl_list_add_tail(list, cl_list_iterator_next(iterator));
-	}
-	cl_list_destroy(alphabetized);
+	for(i = 0; i < count; i++) cl_list_add_tail(list, strings[i]);
+	jl_mem(jl, strings, 0);
 }
@@ -1,5 +1,10 @@
 #include "jl_pr.h"
 
+// Defined here, so don't profile the definitions.
+#undef jl_data_make
+#undef jl_data_mkfrom_str
+#undef jl_data_mkfrom_data
+
 //
 // Internal Functions
 //
@@ -10,11 +15,27 @@ static void jl_data_truncate_curs__(data_t* pstr) {
 	}
 }
 
-static void jl_data_increment(data_t* pstr, u8_t incrementation) {
+static void jl_data_increment(data_t* pstr, u32_t incrementation) {
 	pstr->curs += incrementation;
 	jl_data_truncate_curs__(pstr);
 }
 
+// Set the allocated space of "pstr" to exactly "cap" bytes ( + NUL ).
+static void jl_data_realloc__(jl_t* jl, data_t* pstr, u32_t cap) {
+	pstr->data = jl_mem__(jl, pstr->data, cap + 1, JL_MEM_TAG_DATA);
+	pstr->cap = cap;
+}
+
+// Make room for at least "size" bytes, doubling so appends are amortized O(1).
+static void jl_data_grow__(jl_t* jl, data_t* pstr, u32_t size) {
+	m_u32_t cap = pstr->cap;
+
+	if(size <= cap) return;
+	if(cap < JL_DATA_MIN_CAP) cap = JL_DATA_MIN_CAP;
+	while(cap < size) cap = (cap > UINT32_MAX / 2) ? size : cap * 2;
+	jl_data_realloc__(jl, pstr, cap);
+}
+
 //
 // Exported Functions
 //
@@ -36,9 +57,10 @@ void jl_data_clear(jl_t* jl, data_t* pa) {
  * @returns: A new initialized "strt".
 */
 data_t* jl_data_make(u32_t size) {
-	data_t* a = malloc(sizeof(data_t));
-	a->data = malloc(size+1);
+	data_t* a = jl_mem__(NULL, NULL, sizeof(data_t), JL_MEM_TAG_DATA);
+	a->data = jl_mem__(NULL, NULL, size+1, JL_MEM_TAG_DATA);
 	a->size = size;
+	a->cap = size;
 	a->curs = 0;
 	jl_mem_clr(a->data, a->size + 1);
 	return a;
@@ -49,8 +71,8 @@ data_t* jl_data_make(u32_t size) {
  * @param pstr: the "strt" to free
 */
 void jl_data_free(data_t* pstr) {
-	free(pstr->data);
-	free(pstr);
+	jl_mem__(NULL, pstr->data, 0, JL_MEM_TAG_DATA);
+	jl_mem__(NULL, pstr, 0, JL_MEM_TAG_DATA);
 }
 
 /**
@@ -92,28 +114,34 @@ u8_t jl_data_get_byte(data_t* pstr) {
 }
 
 /**
- * Get data at the cursor of "pstr", and increment the cursor value.
+ * Get data at the cursor of "pstr", and increment the cursor value.  Bytes
+ * past the end of "pstr" are read as 0.
  * @param pstr: the string to read.
  * @param varsize: the size of variable pointed to by "var" in bytes (1,2,4,8).
  * @param var: the variable to save the data to.
 **/
 void jl_data_loadto(data_t* pstr, u32_t varsize, void* var) {
 	void* area = ((void*)pstr->data) + pstr->curs;
+	u32_t left = pstr->curs < pstr->size ? pstr->size - pstr->curs : 0;
+	u32_t size = varsize < left ? varsize : left;
 
-	jl_mem_copyto(area, var, varsize);
-	jl_data_increment(pstr, varsize);
+	jl_mem_copyto(area, var, size);
+	jl_mem_clr(var + size, varsize - size);
+	jl_data_increment(pstr, size);
 }
 
 /**
  * Add variable data at the cursor of "pstr", and increment the cursor value.
+ * Bytes that don't fit in "pstr" are dropped, use jl_stream_write() to grow.
  * @param pstr: the string to read.
  * @param: pval: the integer to add to "pstr"
 */
 void jl_data_saveto(data_t* pstr, u32_t varsize, const void* var) {
 	void* area = ((void*)pstr->data) + pstr->curs;
+	u32_t left = pstr->curs < pstr->size ? pstr->size - pstr->curs : 0;
 
-	jl_mem_copyto(var, area, varsize);
-	jl_data_increment(pstr, varsize);
+	jl_mem_copyto(var, area, varsize < left ? varsize : left);
+	jl_data_increment(pstr, varsize < left ? varsize : left);
 }
 
 /**
@@ -129,59 +157,78 @@ void jl_data_add_byte(data_t* pstr, u8_t pvalue) {
 }
 
 /**
- * Delete byte at cursor in string.
+ * Delete byte at cursor in string.  Doesn't free any memory, use
+ * jl_data_shrink() for that.
 */
 void jl_data_delete_byte(jl_t *jl, data_t* pstr) {
-	int i;
-	
 	if(pstr->size == 0) return;
-	for(i = pstr->curs; i < pstr->size - 1; i++)
-		pstr->data[i] = pstr->data[i+1];
+	jl_data_truncate_curs__(pstr);
+	if(pstr->curs == pstr->size) return;
+	memmove(pstr->data + pstr->curs, pstr->data + pstr->curs + 1,
+		pstr->size - pstr->curs - 1);
 	pstr->size--;
 	pstr->data[pstr->size] = '\0';
-	pstr->data = jl_mem(jl, pstr->data, pstr->size);
-	jl_data_truncate_curs__(pstr);
 }
 
+/**
+ * Set the length of a string.  Memory is only allocated when growing past the
+ * allocated space.  New bytes aren't cleared.
+ * @param jl: The library context.
+ * @param pstr: The string to resize.
+ * @param newsize: The new length of "pstr".
+*/
 void jl_data_resize(jl_t *jl, data_t* pstr, u32_t newsize) {
+	jl_data_grow__(jl, pstr, newsize);
 	pstr->size = newsize;
-	pstr->data = jl_mem(jl, pstr->data, pstr->size);
+	pstr->data[pstr->size] = '\0';
+	jl_data_truncate_curs__(pstr);
+}
+
+/**
+ * Allocate space for at least "cap" bytes, so the string can grow to that
+ * length without allocating.
+ * @param jl: The library context.
+ * @param pstr: The string.
+ * @param cap: How many bytes to make room for.
+*/
+void jl_data_reserve(jl_t *jl, data_t* pstr, u32_t cap) {
+	if(cap > pstr->cap) jl_data_realloc__(jl, pstr, cap);
+}
+
+/**
+ * Free allocated space that's past the length of the string.
+ * @param jl: The library context.
+ * @param pstr: The string.
+*/
+void jl_data_shrink(jl_t *jl, data_t* pstr) {
+	if(pstr->cap != pstr->size) jl_data_realloc__(jl, pstr, pstr->size);
 }
 
 /**
- * Inserts a byte at cursor in string pstr.  If not enough size is available,
- * the new memory will be allocated. Value 0 is treated as null byte - dont use.
+ * Inserts a byte at cursor in string pstr, and moves the cursor past it.  If
+ * not enough space is available, more is allocated.
 */
 void jl_data_insert_byte(jl_t *jl, data_t* pstr, uint8_t pvalue) {
-	if(strlen((char*)pstr->data) == pstr->size) {
-		jl_data_resize(jl, pstr, pstr->size + 1);
-	}
-	if(jl_data_byte(pstr) == '\0') {
-		jl_data_add_byte(pstr, pvalue);
-		jl_data_add_byte(pstr, '\0');
-	}else{
-		int i;
-		uint32_t pstr_len = pstr->size;
-		pstr->data[pstr_len] = '\0';
-		for(i = pstr_len - 1; i > pstr->curs; i--)
-			pstr->data[i] = pstr->data[i-1];
-		jl_data_add_byte(pstr, pvalue);
-	}
+	jl_data_insert_data(jl, pstr, &pvalue, 1);
 }
 
+/**
+ * Inserts "size" bytes of "data" at cursor in string pstr, and moves the cursor
+ * past them.  If not enough space is available, more is allocated.
+*/
 void jl_data_insert_data(jl_t *jl, data_t* pstr, void* data, u32_t size) {
-//	int i;
-//	uint8_t* data2 = data;
-
+	jl_data_truncate_curs__(pstr);
 	// Add size
-	jl_data_resize(jl, pstr, pstr->size + size);
+	jl_data_grow__(jl, pstr, pstr->size + size);
+	// Move the data after the cursor out of the way.
+	memmove(pstr->data + pstr->curs + size, pstr->data + pstr->curs,
+		pstr->size - pstr->curs);
 	// Copy data.
 	jl_mem_copyto(data, pstr->data + pstr->curs, size);
+	pstr->size += size;
+	pstr->data[pstr->size] = '\0';
 	// Increase cursor
-	pstr->curs+=size;
-//	for(i = 0; i < size; i++) {
-//		jl_data_insert_byte(jl, pstr, data2[i]);
-//	}
+	pstr->curs += size;
 }
 
 /**
@@ -197,7 +244,6 @@ void jl_data_insert_data(jl_t *jl, data_t* pstr, void* data, u32_t size) {
  * @param bytes: the number of bytes to copy over
  */
 void jl_data_data(jl_t *jl, data_t* a, const data_t* b, uint64_t bytes) {
-	int32_t i;
 	uint32_t size = a->size;
 	uint32_t sizeb = a->curs + bytes;
 
@@ -209,10 +255,8 @@ void jl_data_data(jl_t *jl, data_t* a, const data_t* b, uint64_t bytes) {
 		exit(-1);
 	}
 	if(sizeb > size) size = sizeb;
-	a->data = jl_mem(jl, a->data, size + 1);
-	for(i = 0; i < bytes; i++) {
-		a->data[i + a->curs] = b->data[i + b->curs];
-	}
+	jl_data_grow__(jl, a, size);
+	jl_mem_copyto(b->data + b->curs, a->data + a->curs, bytes);
 	a->size = size;
 	a->data[a->size] = '\0';
 }
@@ -235,23 +279,69 @@ void jl_data_merg(jl_t *jl, data_t* a, const data_t* b) {
  * @param 'size': size to truncate to.
  */
 void jl_data_trunc(jl_t *jl, data_t* a, uint32_t size) {
+	jl_data_resize(jl, a, size);
+	a->curs = 0;
+}
+
+/**
+ * Format a string directly into "a", growing it to fit.  "a"'s size is set to
+ * the length of the formatted string, and it's cursor is reset.
+ * @param jl: The library context.
+ * @param a: The data_t to format into.
+ * @param format: The format string, followed by it's arguments.
+**/
+void jl_data_format(jl_t* jl, data_t* a, str_t format, ... ) {
+	va_list arglist;
+	int len;
+
+	va_start( arglist, format );
+	len = vsnprintf((char*)a->data, a->cap + 1, format, arglist);
+	va_end( arglist );
+	if(len < 0) len = 0;
+	// Didn't fit: grow "a" and format again.
+	if(len > a->cap) {
+		jl_data_realloc__(jl, a, len);
+		va_start( arglist, format );
+		vsnprintf((char*)a->data, len + 1, format, arglist);
+		va_end( arglist );
+	}
+	a->size = len;
+	a->data[a->size] = '\0';
 	a->curs = 0;
-	a->size = size;
-	a->data = jl_mem(jl, a->data, a->size + 1);
 }
 
 /**
  * Get a string ( char * ) from a 'strt'.  Then, free the 'strt'.
  * @param jl: The library context.
  * @param a: the 'strt' to convert to a string ( char * )
- * @returns: a new string (char *) with the same contents as "a"
+ * @returns: a new string (char *) with the same contents as "a", free it with
+ *	jl_mem().
 */
 char* jl_data_tostring(jl_t* jl, data_t* a) {
 	char *rtn = (void*)a->data;
-	free(a);
+	jl_mem__(jl, a, 0, JL_MEM_TAG_DATA);
 	return rtn;
 }
 
+/**
+ * Make a view of memory owned by someone else.
+ * @param data: The memory to view ( must outlive the view ).
+ * @param size: How many bytes to view.
+ * @returns: The view, with it's cursor at 0.
+*/
+jl_view_t jl_view_make(const void* data, u32_t size) {
+	return (jl_view_t) { data, size, 0 };
+}
+
+/**
+ * Make a view of all of a data_t, without copying it.
+ * @param a: The data_t to view ( must outlive the view, and not be resized ).
+ * @returns: The view, with the same cursor as "a".
+*/
+jl_view_t jl_data_view(const data_t* a) {
+	return (jl_view_t) { a->data, a->size, a->curs };
+}
+
 /**
  * Tests if the next thing in array script is equivalent to particle.
  * @param script: The array script.
@@ -260,13 +350,12 @@ char* jl_data_tostring(jl_t* jl, data_t* a) {
  * @return 0: If particle is not at the cursor.
 */
 u8_t jl_data_test_next(data_t* script, str_t particle) {
-	char * point = (void*)script->data + script->curs; //the cursor
-	char * place = strstr(point, particle); //search for partical
-	if(place == point) {//if partical at begining return true otherwise false
-		return 1;
-	}else{
-		return 0;
-	}
+	u32_t len = strlen(particle);
+
+	jl_data_truncate_curs__(script);
+	// Only compare at the cursor, don't search the rest of the script.
+	if(len > script->size - script->curs) return 0;
+	return memcmp(script->data + script->curs, particle, len) == 0;
 }
 
 /**
@@ -279,14 +368,83 @@ u8_t jl_data_test_next(data_t* script, str_t particle) {
  * @returns: a "strt" that is a truncated array script.
 */
 data_t* jl_data_read_upto(jl_t* jl, data_t* script, u8_t end, u32_t psize) {
-	data_t* compiled = jl_data_make(psize);
-	compiled->curs = 0;
-	while((jl_data_byte(script) != end) && (jl_data_byte(script) != 0)) {
-		strncat((void*)compiled->data,
-			(void*)script->data + script->curs, 1);
+	jl_view_t upto = jl_data_read_until(script, end);
+	const uint8_t* nul = memchr(upto.data, '\0', upto.size);
+	m_u32_t size = nul ? nul - upto.data : upto.size;
+
+	if(size > psize) size = psize;
+	// Leave the cursor after the bytes that were read.
+	script->curs = (upto.data - script->data) + size;
+	return jl_data_mkfrom_data(jl, size, upto.data);
+}
+
+/**
+ * Get the bytes from the cursor up to the byte "end" ( or the end of "script"),
+ * without copying them.  The cursor is left on "end".
+ * @param script: The array script.
+ * @param end: The byte to stop at.
+ * @returns: A view of the bytes before "end", valid until "script" changes.
+*/
+jl_view_t jl_data_read_until(data_t* script, u8_t end) {
+	jl_view_t rtn;
+	const uint8_t* found;
+
+	jl_data_truncate_curs__(script);
+	rtn.data = script->data + script->curs;
+	rtn.curs = 0;
+	// memchr() is vectorized by the C library.
+	found = memchr(rtn.data, end, script->size - script->curs);
+	rtn.size = found ? found - rtn.data : script->size - script->curs;
+	script->curs += rtn.size;
+	return rtn;
+}
+
+/**
+ * If "particle" is at the cursor, move the cursor past it.
+ * @param script: The array script.
+ * @param particle: The phrase to look for.
+ * @return 1: If particle was at the cursor.
+ * @return 0: If particle wasn't at the cursor ( cursor is left alone ).
+*/
+u8_t jl_data_match(data_t* script, str_t particle) {
+	if(!jl_data_test_next(script, particle)) return 0;
+	script->curs += strlen(particle);
+	return 1;
+}
+
+/**
+ * Move the cursor past spaces, tabs and newlines.
+ * @param script: The array script.
+*/
+void jl_data_skip_space(data_t* script) {
+	jl_data_truncate_curs__(script);
+	while(script->curs < script->size) {
+		u8_t byte = script->data[script->curs];
+
+		if(byte != ' ' && byte != '\t' && byte != '\n' && byte != '\r')
+			break;
 		script->curs++;
-		compiled->curs++;
 	}
-	jl_data_trunc(jl, compiled, compiled->curs);
-	return compiled;
+}
+
+/**
+ * Get the next field of "script" separated by "delim", without copying it.
+ *	data_t* script = jl_data_mkfrom_str("a,b,c");
+ *	jl_view_t field;
+ *	while(jl_data_split(script, ',', &field)) {
+ *		// field is "a", then "b", then "c"
+ *	}
+ * @param script: The array script.
+ * @param delim: The byte between fields.
+ * @param field: Set to the next field, valid until "script" changes.
+ * @return 1: If a field was found.
+ * @return 0: If the cursor was already at the end.
+*/
+u8_t jl_data_split(data_t* script, u8_t delim, jl_view_t* field) {
+	jl_data_truncate_curs__(script);
+	if(script->curs == script->size) return 0;
+	*field = jl_data_read_until(script, delim);
+	// Skip the delimiter.
+	if(script->curs < script->size) script->curs++;
+	return 1;
 }
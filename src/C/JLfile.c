@@ -35,34 +35,31 @@ str_t jl_file_convert__(jl_t* jl, str_t filename) {
 		jl_data_merg(_jl->jl, converted, _jl->fl.separator);
 	}
 	while(1) {
-		data_t* append = jl_data_read_upto(jl, src, '/', 300); 
-		if(append->data[0] == '\0') break;
-		jl_data_merg(_jl->jl, converted, append);
+		jl_view_t append = jl_data_read_until(src, '/');
+
+		if(append.size == 0) break;
+		converted->curs = converted->size;
+		jl_data_insert_data(jl, converted, (void*)append.data,
+			append.size);
 		if(jl_data_byte(src) == '/')
 			jl_data_merg(_jl->jl,converted,_jl->fl.separator);
 		src->curs++; // Skip '/'
-		jl_data_free(append);
 	}
 	jl_data_free(src);
 	return jl_data_tostring(jl, converted);
 }
 
-static int jl_file_save_(jl_t* jl, const void *file_data, const char *file_name,
-	uint32_t bytes)
-{
+// Open a file to save to ( made if it doesn't exist ), quitting on failure.
+static int jl_file_save_open__(jl_t* jl, const char *file_name) {
 	int errsv;
-	ssize_t n_bytes;
 	int fd;
-	
+
 	if(file_name == NULL) {
 		jl_print(jl, "Save[file_name]: is Null");
 		exit(-1);
 	}else if(strlen(file_name) == 0) {
 		jl_print(jl, "Save[strlen]: file_name is Empty String");
 		exit(-1);
-	}else if(!file_data) {
-		jl_print(jl, "Save[file_data]: file_data is NULL");
-		exit(-1);
 	}
 
 	str_t converted_filename = jl_file_convert__(jl, file_name);
@@ -77,15 +74,37 @@ static int jl_file_save_(jl_t* jl, const void *file_data, const char *file_name,
 		jl_print(jl, "\tWrite failed: %s", strerror(errsv));
 		exit(-1);
 	}
-	int at = lseek(fd, 0, SEEK_END);
+	return fd;
+}
+
+// Write to a file opened with jl_file_save_open__(), quitting on failure.
+static void jl_file_save_write__(jl_t* jl, int fd, const void *file_data,
+	uint32_t bytes)
+{
+	int errsv;
+	ssize_t n_bytes;
+
+	if(!file_data) {
+		jl_print(jl, "Save[file_data]: file_data is NULL");
+		exit(-1);
+	}
 	n_bytes = write(fd, file_data, bytes);
 	if(n_bytes <= 0) {
 		errsv = errno;
 		close(fd);
-		jl_print(jl, ":Save[write]: Write to \"%s\" failed:");
+		jl_print(jl, ":Save[write]: Write failed:");
 		jl_print(jl, "\"%s\"", strerror(errsv));
 		exit(-1);
 	}
+}
+
+static int jl_file_save_(jl_t* jl, const void *file_data, const char *file_name,
+	uint32_t bytes)
+{
+	int fd = jl_file_save_open__(jl, file_name);
+	int at = lseek(fd, 0, SEEK_END);
+
+	jl_file_save_write__(jl, fd, file_data, bytes);
 	close(fd);
 	return at;
 }
@@ -240,18 +259,17 @@ void jl_file_save(jl_t* jl, const void *file, const char *name, uint32_t bytes)
 	jl_file_save_(jl, file, name, bytes);
 }
 
-/**
- * Load a File from the file system.  Returns bytes loaded from "file_name"
- * @param jl: Library Context
- * @param file_name: file to load
- * @returns A readable "strt" containing the bytes from the file.
- */
-data_t* jl_file_load(jl_t* jl, str_t file_name) {
+// Load a file, setting "size" to the bytes read ( not jl->info, so it can run
+// on any thread ).
+static data_t* jl_file_load__(jl_t* jl, str_t file_name, m_u32_t* size_) {
 	jl_file_reset_cursor__(file_name);
-	unsigned char *file = malloc(MAXFILELEN);
 	str_t converted_filename = jl_file_convert__(jl, file_name);
 	int fd = open(converted_filename, O_RDWR);
-	
+	struct stat st;
+	data_t* rtn;
+	m_u32_t size = MAXFILELEN, got = 0;
+
+	jl_mem(jl, (void*)converted_filename, 0);
 	//Open Block FLLD
 	jl_print_function(jl, "FL_Load");
 	
@@ -268,20 +286,111 @@ data_t* jl_file_load(jl_t* jl, str_t file_name) {
 			// Is a Directory
 			exit(-1);
 		}
+		*size_ = 0;
 		return NULL;
 	}
-	int Read = read(fd, file, MAXFILELEN);
-	jl->info = Read;
+	// Read straight into the returned data ( no scratch buffer & copy ).
+	// Pipes, devices & procfs files report no size, so read up to the max.
+	if(fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0 &&
+		st.st_size < MAXFILELEN) size = st.st_size;
+	rtn = jl_data_make(0);
+	jl_data_reserve(jl, rtn, size);
+	while(got < size) {
+		int Read = read(fd, rtn->data + got, size - got);
+
+		if(Read <= 0) break;
+		got += Read;
+	}
+	*size_ = got;
+	rtn->size = got;
+	rtn->data[rtn->size] = '\0';
 
-	jl_print(jl, "jl_file_load(): read %d bytes", jl->info);
+	jl_print(jl, "jl_file_load(): read %d bytes", got);
 	close(fd);
 
-	data_t* rtn = jl->info ? jl_data_mkfrom_data(jl, jl->info, file) : NULL;
-	
+	if(got == 0) {
+		jl_data_free(rtn);
+		rtn = NULL;
+	}
 	jl_print_return(jl, "FL_Load"); //Close Block "FLLD"
 	return rtn;
 }
 
+/**
+ * Load a File from the file system.  Returns bytes loaded from "file_name"
+ * & sets jl->info to the number of bytes.
+ * @param jl: Library Context
+ * @param file_name: file to load
+ * @returns A readable "strt" containing the bytes from the file, which the
+ *	caller owns ( free it with jl_data_free() ).
+ */
+data_t* jl_file_load(jl_t* jl, str_t file_name) {
+	m_u32_t size;
+	data_t* rtn = jl_file_load__(jl, file_name, &size);
+
+	jl->info = size;
+	return rtn;
+}
+
+/**
+ * Save a rope to the file system, replacing file "name".
+ * @param jl: Library Context
+ * @param rope: The data to save.
+ * @param name: The Name Of The File to save to
+ */
+void jl_file_save_rope(jl_t* jl, jl_rope_t* rope, str_t name) {
+	u64_t curs = rope->curs;
+	jl_view_t part;
+	int fd;
+
+	jl_file_rm(jl, name);
+	// Open once for all of the chunks.
+	fd = jl_file_save_open__(jl, name);
+	rope->curs = 0;
+	while((part = jl_rope_chunk(rope)).size)
+		jl_file_save_write__(jl, fd, part.data, part.size);
+	rope->curs = curs;
+	close(fd);
+}
+
+/**
+ * Load a file of any size from the file system.  Unlike jl_file_load(), the
+ * file isn't limited to MAXFILELEN bytes.
+ * @param jl: Library Context
+ * @param file_name: file to load
+ * @returns: The file's contents, which the caller owns ( free it with
+ *	jl_rope_free() ), or NULL if it can't be opened or is empty.
+ */
+jl_rope_t* jl_file_load_rope(jl_t* jl, str_t file_name) {
+	str_t converted_filename = jl_file_convert__(jl, file_name);
+	int fd = open(converted_filename, O_RDONLY);
+	jl_rope_t* rtn;
+
+	jl_mem(jl, (void*)converted_filename, 0);
+	if(fd <= 0) {
+		jl_print(jl, "jl_file_load_rope: Failed to open \"%s\": %s",
+			file_name, strerror(errno));
+		return NULL;
+	}
+	// Read straight into the rope's chunks.
+	rtn = jl_rope_make(jl);
+	while(1) {
+		m_u32_t room;
+		uint8_t* dst = jl_rope_tail__(jl, rtn, &room);
+		ssize_t Read = read(fd, dst, room);
+
+		if(Read <= 0) break;
+		rtn->size += Read;
+	}
+	close(fd);
+	jl_print(jl, "jl_file_load_rope(): read %ld bytes", (long)rtn->size);
+	if(rtn->size == 0) {
+		jl_rope_free(jl, rtn);
+		return NULL;
+	}
+	return rtn;
+}
+
 /**
  * Save file "filename" with contents "data" of size "dataSize" to package
  * "packageFileName"
@@ -333,13 +442,12 @@ static void _jl_file_pk_load_quit(jl_t* jl) {
 	jl_print_return(jl, "FL_PkLd"); //Close Block "FL_PkLd"
 }
 
-/**
- * Load a zip package from memory.
- * @param jl: The library context.
- * @param data: The data that contains the zip file.
- * @param file_name: The name of the file to load.
-**/
-data_t* jl_file_pk_load_fdata(jl_t* jl, data_t* data, str_t file_name) {
+// Load a file from a zip package in memory, setting "errf" ( not jl->errf, so
+// it can run on any thread ).
+static data_t* jl_file_pk_load_fdata__(jl_t* jl, data_t* data, str_t file_name,
+	jl_err_t* errf)
+{
+	zip_int64_t got;
 	data_t* rtn;
 	zip_error_t ze; ze.zip_err = ZIP_ER_OK;
 	zip_source_t *file_data;
@@ -384,7 +492,14 @@ data_t* jl_file_pk_load_fdata(jl_t* jl, data_t* data, str_t file_name) {
 	JL_PRINT_DEBUG(jl, "error check 4.");
 	JL_PRINT_DEBUG(jl, (char *)zip_strerror(zipfile));
 	JL_PRINT_DEBUG(jl, "loaded package.");
-	unsigned char *fileToLoad = malloc(PKFMAX);
+	// Decompress straight into the returned data ( no scratch buffer ).
+	zip_stat_t st;
+	m_u32_t size = PKFMAX;
+
+	if(zip_stat(zipfile, file_name, 0, &st) == 0 &&
+		(st.valid & ZIP_STAT_SIZE) && st.size < PKFMAX) size = st.size;
+	rtn = jl_data_make(0);
+	jl_data_reserve(jl, rtn, size);
 	JL_PRINT_DEBUG(jl, "opening file in package....");
 	struct zip_file *file = zip_fopen(zipfile, file_name, ZIP_FL_UNCHANGED);
 	JL_PRINT_DEBUG(jl, "call pass.");
@@ -392,32 +507,137 @@ data_t* jl_file_pk_load_fdata(jl_t* jl, data_t* data, str_t file_name) {
 		jl_print(jl, "couldn't open up file: \"%s\" in package:",
 			file_name);
 		jl_print(jl, "because: %s", (void *)zip_strerror(zipfile));
-		jl->errf = JL_ERR_NONE;
+		*errf = JL_ERR_NONE;
 		_jl_file_pk_load_quit(jl);
+		zip_close(zipfile);
+		jl_data_free(rtn);
 		return NULL;
 	}
 	JL_PRINT_DEBUG(jl, "opened file in package / reading opened file....");
-	if((jl->info = zip_fread(file, fileToLoad, PKFMAX)) == -1) {
+	if((got = zip_fread(file, rtn->data, size)) == -1) {
 		jl_print(jl, "file reading failed");
 		_jl_file_pk_load_quit(jl);
 		exit(-1);
 	}
-	if(jl->info == 0) {
+	if(got == 0) {
 		JL_PRINT_DEBUG(jl, "empty file, returning NULL.");
 		_jl_file_pk_load_quit(jl);
+		zip_fclose(file);
+		zip_close(zipfile);
+		jl_data_free(rtn);
 		return NULL;
 	}
-	JL_PRINT_DEBUG(jl, "jl_file_pk_load: read %d bytes", jl->info);
+	JL_PRINT_DEBUG(jl, "jl_file_pk_load: read %d bytes", (int)got);
+	zip_fclose(file);
 	zip_close(zipfile);
 	JL_PRINT_DEBUG(jl, "closed file.");
-	// Make a data_t* from the data.
-	rtn = jl->info ? jl_data_mkfrom_data(jl, jl->info, fileToLoad) : NULL;
+	rtn->size = got;
+	rtn->data[rtn->size] = '\0';
 	JL_PRINT_DEBUG(jl, "done.");
-	jl->errf = JL_ERR_NERR;
+	*errf = JL_ERR_NERR;
 	_jl_file_pk_load_quit(jl);
 	return rtn;
 }
 
+/**
+ * Load a zip package from memory.
+ * @param jl: The library context.
+ * @param data: The data that contains the zip file ( borrowed, not freed ).
+ * @param file_name: The name of the file to load.
+ * @returns: The file's contents, which the caller owns ( free it with
+ *	jl_data_free() ), or NULL.
+**/
+data_t* jl_file_pk_load_fdata(jl_t* jl, data_t* data, str_t file_name) {
+	data_t* rtn = jl_file_pk_load_fdata__(jl, data, file_name, &jl->errf);
+
+	jl->info = rtn ? rtn->size : 0;
+	return rtn;
+}
+
+/**
+ * Load a file of any size from a zip package in memory.  Unlike
+ * jl_file_pk_load_fdata(), the file isn't limited to PKFMAX bytes.
+ * @param jl: The library context.
+ * @param data: The data that contains the zip file ( borrowed, not freed ).
+ * @param file_name: The name of the file to load.
+ * @returns: The file's contents, which the caller owns ( free it with
+ *	jl_rope_free() ), or NULL if it can't be found or is empty.
+**/
+jl_rope_t* jl_file_pk_load_rope(jl_t* jl, data_t* data, str_t file_name) {
+	zip_error_t ze; ze.zip_err = ZIP_ER_OK;
+	zip_source_t *file_data;
+	struct zip *zipfile;
+	struct zip_file *file;
+	jl_rope_t* rtn;
+
+	file_data = zip_source_buffer_create(data->data, data->size, 0, &ze);
+	if(ze.zip_err != ZIP_ER_OK) {
+		jl_print(jl, "couldn't make pckg buffer: \"%s\"",
+			zip_error_strerror(&ze));
+		return NULL;
+	}
+	zipfile = zip_open_from_source(file_data, ZIP_CHECKCONS | ZIP_RDONLY,
+		&ze);
+	if(zipfile == NULL || ze.zip_err != ZIP_ER_OK) {
+		jl_print(jl, "couldn't load pckg file: \"%s\"",
+			zip_error_strerror(&ze));
+		zip_source_free(file_data);
+		return NULL;
+	}
+	if((file = zip_fopen(zipfile, file_name, ZIP_FL_UNCHANGED)) == NULL) {
+		jl_print(jl, "couldn't open up file: \"%s\" in package: %s",
+			file_name, zip_strerror(zipfile));
+		zip_close(zipfile);
+		return NULL;
+	}
+	// Decompress straight into the rope's chunks.
+	rtn = jl_rope_make(jl);
+	while(1) {
+		m_u32_t room;
+		uint8_t* dst = jl_rope_tail__(jl, rtn, &room);
+		zip_int64_t Read = zip_fread(file, dst, room);
+
+		if(Read <= 0) break;
+		rtn->size += Read;
+	}
+	zip_fclose(file);
+	zip_close(zipfile);
+	JL_PRINT_DEBUG(jl, "jl_file_pk_load_rope: read %ld bytes",
+		(long)rtn->size);
+	if(rtn->size == 0) {
+		jl_rope_free(jl, rtn);
+		return NULL;
+	}
+	return rtn;
+}
+
+// Load a file from a package, setting "errf" ( see jl_file_pk_load() ).  Never
+// touches jl->errf or jl->info, so it can run on a job worker.
+static data_t* jl_file_pk_load__(jl_t* jl, str_t packageFileName,
+	str_t filename, jl_err_t* errf)
+{
+	str_t converted = jl_file_convert__(jl, packageFileName);
+	m_u32_t size;
+
+	*errf = JL_ERR_NERR;
+	jl_print_function(jl, "FL_PkLd");
+
+	JL_PRINT_DEBUG(jl, "loading package:\"%s\"...", converted);
+
+	data_t* data = jl_file_load__(jl, converted, &size);
+	JL_PRINT_DEBUG(jl, "error check 1.");
+	if(data == NULL) {
+		JL_PRINT_DEBUG(jl, "!Package File doesn't exist!");
+		*errf = JL_ERR_FIND;
+		_jl_file_pk_load_quit(jl);
+		return NULL;
+	}
+	// The package is only needed until the file is decompressed.
+	data_t* rtn = jl_file_pk_load_fdata__(jl, data, filename, errf);
+	jl_data_free(data);
+	return rtn;
+}
+
 /**
  * Load file "filename" in package "packageFileName" & Return contents
  * May return NULL.  If it does jl->errf will be set.
@@ -433,22 +653,49 @@ data_t* jl_file_pk_load_fdata(jl_t* jl, data_t* data, str_t file_name) {
 data_t* jl_file_pk_load(jl_t* jl, const char *packageFileName,
 	const char *filename)
 {
-	str_t converted = jl_file_convert__(jl, packageFileName);
+	data_t* rtn = jl_file_pk_load__(jl, packageFileName, filename,
+		&jl->errf);
 
-	jl->errf = JL_ERR_NERR;
-	jl_print_function(jl, "FL_PkLd");
+	jl->info = rtn ? rtn->size : 0;
+	return rtn;
+}
 
-	JL_PRINT_DEBUG(jl, "loading package:\"%s\"...", converted);
+// A package load for jl_file_pk_load_async() ( owns copies of the names ).
+typedef struct{
+	m_str_t package;
+	m_str_t filename;
+}jl_file_pk_async_t;
+
+static void* jl_file_pk_load_async__(jl_t* jl, void* arg) {
+	jl_file_pk_async_t* load = arg;
+	jl_err_t errf;
+	data_t* rtn = jl_file_pk_load__(jl, load->package, load->filename,
+		&errf);
+
+	jl_mem(jl, load->package, 0);
+	jl_mem(jl, load->filename, 0);
+	jl_mem(jl, load, 0);
+	return rtn;
+}
 
-	data_t* data = jl_file_load(jl, converted);
-	JL_PRINT_DEBUG(jl, "error check 1.");
-	if(data == NULL) {
-		JL_PRINT_DEBUG(jl, "!Package File doesn't exist!");
-		jl->errf = JL_ERR_FIND;
-		_jl_file_pk_load_quit(jl);
-		return NULL;
-	}
-	return jl_file_pk_load_fdata(jl, data, filename);
+/**
+ * Load a file from a package on a job worker, so the calling thread can keep
+ * drawing frames.  See jl_file_pk_load().  jl->errf & jl->info aren't set.
+ * @param jl: Library Context
+ * @param packageFileName: Package to load file from
+ * @param filename: file within package to load
+ * @returns: A future for the file's contents ( data_t*, or NULL ), see
+ *	jl_future_then() & jl_future_wait().
+**/
+jl_future_t* jl_file_pk_load_async(jl_t* jl, str_t packageFileName,
+	str_t filename)
+{
+	jl_file_pk_async_t* load = jl_memi(jl, sizeof(jl_file_pk_async_t));
+
+	load->package = jl_mem_copy(jl, packageFileName,
+		strlen(packageFileName) + 1);
+	load->filename = jl_mem_copy(jl, filename, strlen(filename) + 1);
+	return jl_async(jl, jl_file_pk_load_async__, load);
 }
 
 /**
@@ -482,17 +729,9 @@ u8_t jl_file_mkdir(jl_t* jl, str_t path) {
 	return rtn;
 }
 
-/**
- * Create the media package file & load a file from it.
- * @param jl: library context
- * @param pfilebase: name of file to load from package
- * @param pzipfile: the name of the zipfile to create.
- * @param contents: the contents to put in the file
- * @param size: the size (in bytes) of the contents.
- * @return x: the data contents of the file.
-*/
-data_t* jl_file_mkfile(jl_t* jl, str_t pzipfile, str_t pfilebase,
-	char *contents, uint32_t size)
+// Create the media package file & load a file from it, setting "errf".
+static data_t* jl_file_mkfile__(jl_t* jl, str_t pzipfile, str_t pfilebase,
+	char *contents, uint32_t size, jl_err_t* errf)
 {
 //	if(!pfilebase) { return; }
 	data_t* rtn;
@@ -504,8 +743,9 @@ data_t* jl_file_mkfile(jl_t* jl, str_t pzipfile, str_t pfilebase,
 	jl_file_save(jl, contents, pzipfile, size);
 	JL_PRINT_DEBUG(jl, "Try loading....");
 	if(
-		((rtn = jl_file_pk_load(jl, pzipfile, pfilebase))== NULL) &&
-		(jl->errf == JL_ERR_FIND) )//Package still doesn't exist!!
+		((rtn = jl_file_pk_load__(jl, pzipfile, pfilebase, errf))
+			== NULL) &&
+		(*errf == JL_ERR_FIND) )//Package still doesn't exist!!
 	{
 		JL_PRINT_DEBUG(jl, "Failed To Create file");
 		jl_print_return(jl, "FL_MkFl");
@@ -517,6 +757,39 @@ data_t* jl_file_mkfile(jl_t* jl, str_t pzipfile, str_t pfilebase,
 	return rtn;
 }
 
+/**
+ * Create the media package file & load a file from it.
+ * @param jl: library context
+ * @param pfilebase: name of file to load from package
+ * @param pzipfile: the name of the zipfile to create.
+ * @param contents: the contents to put in the file
+ * @param size: the size (in bytes) of the contents.
+ * @return x: the data contents of the file.
+*/
+data_t* jl_file_mkfile(jl_t* jl, str_t pzipfile, str_t pfilebase,
+	char *contents, uint32_t size)
+{
+	data_t* rtn = jl_file_mkfile__(jl, pzipfile, pfilebase, contents,
+		size, &jl->errf);
+
+	jl->info = rtn ? rtn->size : 0;
+	return rtn;
+}
+
+// Load a file from the media package, making the package if it doesn't exist.
+static data_t* jl_file_media__(jl_t* jl, str_t Fname, str_t pzipfile,
+	void *pdata, uint64_t psize, jl_err_t* errf)
+{
+	// Try to load package	
+	data_t* rtn = jl_file_pk_load__(jl, pzipfile, Fname, errf);
+	JL_PRINT_DEBUG(jl, "JL_FL_MEDIA Returning");
+	//If Package doesn't exist!! - create
+	if( (rtn == NULL) && (*errf == JL_ERR_FIND) )
+		return jl_file_mkfile__(jl, pzipfile, Fname, pdata, psize, errf);
+	else
+		return rtn;
+}
+
 /**
  * Load media package, create it if it doesn't exist.
  * @param jl: Library Context
@@ -528,14 +801,56 @@ data_t* jl_file_mkfile(jl_t* jl, str_t pzipfile, str_t pfilebase,
 data_t* jl_file_media(jl_t* jl, str_t Fname, str_t pzipfile, void *pdata,
 	uint64_t psize)
 {
-	// Try to load package	
-	data_t* rtn = jl_file_pk_load(jl, pzipfile, Fname);
-	JL_PRINT_DEBUG(jl, "JL_FL_MEDIA Returning");
-	//If Package doesn't exist!! - create
-	if( (rtn == NULL) && (jl->errf == JL_ERR_FIND) )
-		return jl_file_mkfile(jl, pzipfile, Fname, pdata, psize);
-	else
-		return rtn;
+	data_t* rtn = jl_file_media__(jl, Fname, pzipfile, pdata, psize,
+		&jl->errf);
+
+	jl->info = rtn ? rtn->size : 0;
+	return rtn;
+}
+
+// A media load for jl_file_media_async() ( owns copies of the names ).
+typedef struct{
+	m_str_t fname;
+	m_str_t package;
+	void* pdata;
+	m_u64_t psize;
+}jl_file_media_async_t;
+
+static void* jl_file_media_async__(jl_t* jl, void* arg) {
+	jl_file_media_async_t* load = arg;
+	jl_err_t errf;
+	data_t* rtn = jl_file_media__(jl, load->fname, load->package,
+		load->pdata, load->psize, &errf);
+
+	jl_mem(jl, load->fname, 0);
+	jl_mem(jl, load->package, 0);
+	jl_mem(jl, load, 0);
+	return rtn;
+}
+
+/**
+ * Load a file from the media package on a job worker, making the package if
+ * it doesn't exist.  See jl_file_media().  jl->errf & jl->info aren't set.
+ * @param jl: Library Context
+ * @param Fname: File in Media Package to load.
+ * @param pzipfile: Where to make the package.
+ * @param pdata: Media Package Data to save if it doesn't exist ( must stay
+ *	around until the future finishes ).
+ * @param psize: Size of "pdata"
+ * @returns: A future for the file's contents ( data_t*, or NULL ), see
+ *	jl_future_then() & jl_future_wait().
+**/
+jl_future_t* jl_file_media_async(jl_t* jl, str_t Fname, str_t pzipfile,
+	void *pdata, uint64_t psize)
+{
+	jl_file_media_async_t* load = jl_memi(jl,
+		sizeof(jl_file_media_async_t));
+
+	load->fname = jl_mem_copy(jl, Fname, strlen(Fname) + 1);
+	load->package = jl_mem_copy(jl, pzipfile, strlen(pzipfile) + 1);
+	load->pdata = pdata;
+	load->psize = psize;
+	return jl_async(jl, jl_file_media_async__, load);
 }
 
 /**
@@ -609,13 +924,14 @@ void jl_file_init__(jvct_t * _jl) {
 	JL_PRINT_DEBUG(_jl->jl, "Get/Make directory error logfile....");
 	jl_file_get_errf__(_jl);
 	JL_PRINT_DEBUG(_jl->jl, "Complete!");
-	//
+	// Empty the log before the print writer thread can open it, then
+	// publish "errf" before "has.filesys".
+	truncate(_jl->fl.paths.errf, 0);
+	SDL_MemoryBarrierRelease();
 	_jl->has.filesys = 1;
 
 	str_t pkfl = jl_file_get_resloc(_jl->jl, JL_MAIN_DIR, JL_MAIN_MEF);
 	remove(pkfl);
-
-	truncate(_jl->fl.paths.errf, 0);
 	JL_PRINT_DEBUG(_jl->jl, "Starting....");
 	JL_PRINT_DEBUG(_jl->jl, "finished file init");
 	jl_print_return(_jl->jl, "FL_Init");
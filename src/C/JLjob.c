@@ -0,0 +1,265 @@
+/*
+ * JL_Lib
+ * Copyright (c) 2015 Jeron A. Lau
+*/
+/** \file
+ * JLjob.c
+ *	Jobs: small functions run by a pool of worker threads, 1 per core.  Each
+ *	worker has it's own queue and takes the newest job from it; when it runs
+ *	out it steals the oldest job from another queue.  Threads that wait for
+ *	jobs run jobs while they wait.
+**/
+#include "jl_pr.h"
+
+// A job waiting to be run.
+typedef struct{
+	jl_data_fnct fn;
+	void* data;
+	jl_job_counter_t* counter;
+}jl_job_t;
+
+// A worker's queue: the worker uses the bottom, thieves use the top.
+typedef struct{
+	jl_job_t jobs[JL_JOB_QUEUE];	// Ring of jobs
+	m_u32_t top;			// Oldest job ( stolen next )
+	m_u32_t bottom;			// 1 past the newest job ( run next )
+	SDL_SpinLock lock;		// Lock for "top" & "bottom"
+	uint8_t pad[JL_MEM_ALIGN];	// Keep locks on separate cache lines
+}jl_job_queue_t;
+
+static struct {
+	jl_t* jl;
+	jl_job_queue_t* queues;	// Queue 0 is shared by non-worker threads.
+	m_u16_t count;		// # of queues ( workers + 1 )
+	uint16_t* threads;	// Thread IDs of the workers.
+	SDL_sem* wake;		// Posted when jobs are added & workers sleep.
+	SDL_atomic_t sleeping;	// # of workers waiting on "wake".
+	SDL_sem* done;		// Posted when a job finishes & threads nap.
+	SDL_atomic_t napping;	// # of threads waiting on "done".
+	SDL_atomic_t pending;	// # of jobs queued or running.
+	SDL_atomic_t started;	// # of workers that have picked a queue.
+	SDL_atomic_t quit;	// Set to stop the workers.
+}jl_job__;
+// The calling thread's queue ( the shared queue if not a worker ).
+static __thread m_u16_t jl_job_queue__ = 0;
+
+//
+// Internal Functions
+//
+
+static u8_t jl_job_push__(jl_job_queue_t* queue, const jl_job_t* job) {
+	m_u8_t rtn = 0;
+
+	SDL_AtomicLock(&queue->lock);
+	if(queue->bottom - queue->top < JL_JOB_QUEUE) {
+		queue->jobs[queue->bottom & (JL_JOB_QUEUE - 1)] = *job;
+		queue->bottom++;
+		rtn = 1;
+	}
+	SDL_AtomicUnlock(&queue->lock);
+	return rtn;
+}
+
+// Take the newest job ( from the owner ) or the oldest job ( steal ).
+static u8_t jl_job_take__(jl_job_queue_t* queue, jl_job_t* job, u8_t steal) {
+	m_u8_t rtn = 0;
+
+	SDL_AtomicLock(&queue->lock);
+	if(queue->bottom != queue->top) {
+		if(steal) {
+			*job = queue->jobs[queue->top & (JL_JOB_QUEUE - 1)];
+			queue->top++;
+		}else{
+			queue->bottom--;
+			*job = queue->jobs[queue->bottom & (JL_JOB_QUEUE - 1)];
+		}
+		rtn = 1;
+	}
+	SDL_AtomicUnlock(&queue->lock);
+	return rtn;
+}
+
+static void jl_job_exec__(jl_t* jl, const jl_job_t* job) {
+	job->fn(jl, job->data);
+	if(job->counter) SDL_AtomicAdd(&job->counter->count, -1);
+	// After the job's counter, so it's seen once "pending" says done.
+	SDL_AtomicAdd(&jl_job__.pending, -1);
+	if(SDL_AtomicGet(&jl_job__.napping)) SDL_SemPost(jl_job__.done);
+}
+
+// Run 1 job: from this thread's queue, or else stolen from another queue.
+u8_t jl_job_help__(jl_t* jl) {
+	u16_t mine = jl_job_queue__;
+	jl_job_t job;
+	m_u16_t i;
+
+	if(jl_job_take__(&jl_job__.queues[mine], &job, 0)) {
+		jl_job_exec__(jl, &job);
+		return 1;
+	}
+	for(i = 1; i < jl_job__.count; i++) {
+		u16_t victim = (mine + i) % jl_job__.count;
+
+		if(jl_job_take__(&jl_job__.queues[victim], &job, 1)) {
+			jl_job_exec__(jl, &job);
+			return 1;
+		}
+	}
+	return 0;
+}
+
+// Sleep until a job finishes ( or JL_JOB_NAP_MS passes ), unless "value" is
+// already "until".  Jobs are the only thing that change "value".
+void jl_job_nap__(jl_t* jl, SDL_atomic_t* value, int until) {
+	// Say we're napping before checking, so a finish in between posts.
+	SDL_AtomicIncRef(&jl_job__.napping);
+	if(SDL_AtomicGet(value) != until)
+		SDL_SemWaitTimeout(jl_job__.done, JL_JOB_NAP_MS);
+	SDL_AtomicDecRef(&jl_job__.napping);
+}
+
+static u8_t jl_job_any__(void) {
+	m_u16_t i;
+
+	for(i = 0; i < jl_job__.count; i++) {
+		jl_job_queue_t* queue = &jl_job__.queues[i];
+		m_u8_t any;
+
+		SDL_AtomicLock(&queue->lock);
+		any = queue->bottom != queue->top;
+		SDL_AtomicUnlock(&queue->lock);
+		if(any) return 1;
+	}
+	return 0;
+}
+
+static int jl_job_worker__(void* data) {
+	jl_t* jl = data;
+
+	jl_job_queue__ = SDL_AtomicAdd(&jl_job__.started, 1) + 1;
+	while(!SDL_AtomicGet(&jl_job__.quit)) {
+		if(jl_job_help__(jl)) continue;
+		// Nothing to do: say we're asleep, then check again so a job
+		// added in between isn't missed.
+		SDL_AtomicIncRef(&jl_job__.sleeping);
+		if(!jl_job_any__() && !SDL_AtomicGet(&jl_job__.quit))
+			SDL_SemWait(jl_job__.wake);
+		SDL_AtomicDecRef(&jl_job__.sleeping);
+	}
+	return 0;
+}
+
+//
+// Exported Functions
+//
+
+/**
+ * Run a job on a worker thread.  The job may run on any thread, in any order
+ * with other jobs.  If the queue is full, the job runs right away on the
+ * calling thread.
+ * @param jl: The library context.
+ * @param fn: The job's function.
+ * @param data: Passed to "fn".
+ * @param counter: Counts the job until it's finished ( may be NULL ), see
+ *	jl_job_wait().
+**/
+void jl_job_run(jl_t* jl, jl_data_fnct fn, void* data,
+	jl_job_counter_t* counter)
+{
+	jl_job_t job = { fn, data, counter };
+
+	if(counter) SDL_AtomicAdd(&counter->count, 1);
+	// Before it's queued, so a job is never queued without being counted.
+	SDL_AtomicAdd(&jl_job__.pending, 1);
+	if(!jl_job_push__(&jl_job__.queues[jl_job_queue__], &job)) {
+		jl_job_exec__(jl, &job);
+		return;
+	}
+	if(SDL_AtomicGet(&jl_job__.sleeping)) SDL_SemPost(jl_job__.wake);
+}
+
+/**
+ * Wait until all jobs counted by "counter" are finished.  The calling thread
+ * runs jobs while it waits, so jobs may wait on other jobs.
+ * @param jl: The library context.
+ * @param counter: The counter passed to jl_job_run().
+**/
+void jl_job_wait(jl_t* jl, jl_job_counter_t* counter) {
+	while(SDL_AtomicGet(&counter->count)) {
+		// The jobs left are running on other threads.
+		if(!jl_job_help__(jl)) jl_job_nap__(jl, &counter->count, 0);
+	}
+}
+
+/**
+ * Check if all jobs counted by "counter" are finished, without waiting.
+ * @param counter: The counter passed to jl_job_run().
+ * @returns: 1 if finished, 0 if not.
+**/
+u8_t jl_job_done(jl_job_counter_t* counter) {
+	return SDL_AtomicGet(&counter->count) == 0;
+}
+
+/**
+ * Get how many worker threads run jobs.
+ * @param jl: The library context.
+ * @returns: The # of workers ( the cores, minus 1 for the main thread ).
+**/
+u16_t jl_job_workers(jl_t* jl) {
+	return jl_job__.count - 1;
+}
+
+//
+// Internal functions
+//
+
+void jl_job_init__(jl_t* jl) {
+	int cores = SDL_GetCPUCount();
+	jl_thread_opt_t opt = { jl_thread_cpus(jl, JL_THREAD_WORKER), 5 };
+	m_u16_t workers = cores > 2 ? cores - 1 : 1;
+	char name[16];
+	m_u16_t i;
+
+	// When pinned, 1 worker for each of the workers' CPUs.
+	if(opt.cpus) workers = __builtin_popcountll(opt.cpus);
+
+	jl_job__.jl = jl;
+	jl_job__.count = workers + 1;
+	jl_job__.queues = jl_mem_aligned(jl, jl_job__.count *
+		sizeof(jl_job_queue_t), JL_MEM_ALIGN);
+	jl_mem_clr(jl_job__.queues, jl_job__.count * sizeof(jl_job_queue_t));
+	jl_job__.threads = jl_memi(jl, workers * sizeof(uint16_t));
+	jl_job__.wake = SDL_CreateSemaphore(0);
+	SDL_AtomicSet(&jl_job__.sleeping, 0);
+	jl_job__.done = SDL_CreateSemaphore(0);
+	SDL_AtomicSet(&jl_job__.napping, 0);
+	SDL_AtomicSet(&jl_job__.pending, 0);
+	SDL_AtomicSet(&jl_job__.started, 0);
+	SDL_AtomicSet(&jl_job__.quit, 0);
+	// Workers are below the graphics & audio threads' priority.
+	for(i = 0; i < workers; i++) {
+		snprintf(name, sizeof(name), "JL_Lib/Job%d", i);
+		jl_job__.threads[i] = jl_thread_new_opt(jl, name,
+			jl_job_worker__, &opt);
+	}
+	JL_PRINT_DEBUG(jl, "Started %d job workers", workers);
+}
+
+void jl_job_kill__(jl_t* jl) {
+	m_u16_t i;
+
+	// Run whatever's left, including jobs pushed by running jobs, then
+	// stop the workers.
+	while(SDL_AtomicGet(&jl_job__.pending)) {
+		if(!jl_job_help__(jl)) jl_job_nap__(jl, &jl_job__.pending, 0);
+	}
+	SDL_AtomicSet(&jl_job__.quit, 1);
+	for(i = 0; i + 1 < jl_job__.count; i++) SDL_SemPost(jl_job__.wake);
+	for(i = 0; i + 1 < jl_job__.count; i++)
+		jl_thread_old(jl, jl_job__.threads[i]);
+	SDL_DestroySemaphore(jl_job__.wake);
+	SDL_DestroySemaphore(jl_job__.done);
+	jl_mem(jl, jl_job__.threads, 0);
+	jl_mem(jl, jl_job__.queues, 0);
+	jl_job__.count = 0;
+}
@@ -8,19 +8,341 @@
 
 #include "jl_pr.h"
 #include <malloc.h>
+#if defined(__unix__) || defined(__APPLE__)
+	#include <sys/mman.h>
+	#define JL_MEM_LARGE_MMAP
+#endif
+
+// Defined here, so don't profile the definitions.
+#undef jl_mem
+#undef jl_memi
+#undef jl_mem_copy
+#undef jl_mem_aligned
+#undef jl_mem_large
+#undef jl_mem__
+#undef jl_memi__
+#undef jl_mem_aligned__
+#undef jl_mem_large__
+
+#define JL_MEM_PROFILE_SITES 1024 // Max # of call sites for the profiler.
+#define JL_MEM_PROFILE_SHOW 24 // How many call sites to print in a report.
+#define JL_MEM_LARGE_HEADER 64 // Bytes before a large block ( keeps alignment )
+#define JL_MEM_LARGE_MIN (256 * 1024) // Smaller "large" blocks use malloc
+
+/** @cond **/
+
+#ifdef JL_MEM_PROFILE
+typedef struct{
+	str_t file;	// Source file of the call site [ NULL = Unused ]
+	m_i32_t line;	// Line # of the call site.
+	m_u64_t count;	// Number of allocations.
+	m_u64_t bytes;	// Number of bytes allocated.
+}jl_mem_site_t;
+
+// Call site of the allocation in progress on this thread.
+static __thread str_t jl_mem_site_file__ = NULL;
+static __thread m_i32_t jl_mem_site_line__ = 0;
+// Everything below is protected by "jl_mem_profile_lock__".
+static SDL_SpinLock jl_mem_profile_lock__ = 0;
+static jl_mem_site_t jl_mem_profile_sites__[JL_MEM_PROFILE_SITES];
+static m_u64_t jl_mem_profile_sizes__[32]; // # of allocations by log2(size)
+static struct {
+	m_u64_t frames;	// Frames counted.
+	m_u64_t allocs;	// Allocations for all frames.
+	m_u64_t frame;	// Allocations for this frame.
+	m_u64_t peak;	// Most allocations in one frame.
+}jl_mem_profile_rate__;
+
+// Record an allocation of "size" bytes from the current call site.
+static void jl_mem_profile_add__(u64_t size) {
+	str_t file = jl_mem_site_file__ ? jl_mem_site_file__ : "(unknown)";
+	m_u32_t i = (((uintptr_t)file) ^ (jl_mem_site_line__ * 2654435761u))
+		% JL_MEM_PROFILE_SITES;
+	m_u32_t tries, bucket = 0;
+
+	while(bucket < 31 && (((u64_t)1) << (bucket + 1)) <= size) bucket++;
+	SDL_AtomicLock(&jl_mem_profile_lock__);
+	jl_mem_profile_sizes__[bucket]++;
+	jl_mem_profile_rate__.allocs++;
+	jl_mem_profile_rate__.frame++;
+	// Find the call site's slot ( open addressing ).
+	for(tries = 0; tries < JL_MEM_PROFILE_SITES; tries++) {
+		jl_mem_site_t* site = &jl_mem_profile_sites__[i];
+
+		if(site->file == NULL) {
+			site->file = file;
+			site->line = jl_mem_site_line__;
+		}
+		if(site->file == file && site->line == jl_mem_site_line__) {
+			site->count++;
+			site->bytes += size;
+			break;
+		}
+		i = (i + 1) % JL_MEM_PROFILE_SITES;
+	}
+	SDL_AtomicUnlock(&jl_mem_profile_lock__);
+}
+
+// Sort call sites by bytes allocated, most first.
+static int jl_mem_profile_cmp__(const void* a, const void* b) {
+	const jl_mem_site_t* sa = a;
+	const jl_mem_site_t* sb = b;
+
+	if(sa->bytes == sb->bytes) return 0;
+	return sa->bytes < sb->bytes ? 1 : -1;
+}
+#endif
+
+// Live bytes & blocks for each jl_mem_tag_t, updated atomically.
+static m_i64_t jl_mem_bytes__[JL_MEM_TAG_MAX];
+static m_i64_t jl_mem_count__[JL_MEM_TAG_MAX];
+
+// Kept in front of blocks from jl_mem_large().
+typedef struct{
+	m_u64_t size;	// Total size of the block, including this header.
+	m_u8_t mapped;	// 1 if from mmap(), 0 if from jl_mem_aligned__().
+	m_u8_t tag;	// The jl_mem_tag_t the block is counted under.
+}jl_mem_large_t;
+
+static inline void jl_mem_count_add__(jl_mem_tag_t tag, i64_t bytes,
+	i64_t count)
+{
+	__atomic_fetch_add(&jl_mem_bytes__[tag], bytes, __ATOMIC_RELAXED);
+	__atomic_fetch_add(&jl_mem_count__[tag], count, __ATOMIC_RELAXED);
+}
+
+// Memory budget & shrink callbacks ( see jl_mem_budget() ).
+static struct {
+	jl_t* jl;		// Library context ( jl_mem__ may be passed NULL )
+	m_u64_t soft;		// Shrink caches at the next frame [ 0 = none ]
+	m_u64_t hard;		// Shrink caches right away [ 0 = none ]
+	SDL_atomic_t pending;	// Went over "soft" since the last frame.
+	m_u8_t count;		// # of callbacks in "fns"
+	struct {
+		jl_mem_shrink_fnt fn;
+		void* data;
+	}fns[JL_MEM_SHRINK_MAX];
+	m_u64_t shrinks;	// Times caches were asked to shrink.
+	m_i64_t shrunk;		// Bytes freed by shrinking.
+	SDL_SpinLock lock;	// Lock for "fns", "count", "shrinks" & "shrunk"
+}jl_mem_budget__;
+// Set while this thread runs shrink callbacks, so they don't recurse.
+static __thread m_u8_t jl_mem_shrinking__ = 0;
+
+// Check the budget after an allocation.
+static void jl_mem_budget_check__(jl_t* jl) {
+	m_u64_t total;
+
+	if(!jl_mem_budget__.soft && !jl_mem_budget__.hard) return;
+	total = jl_mem_tbiu();
+	if(jl_mem_budget__.soft && total > jl_mem_budget__.soft)
+		SDL_AtomicSet(&jl_mem_budget__.pending, 1);
+	// Over the hard limit: shrink now, if on the main thread.
+	if(jl_mem_budget__.hard && total > jl_mem_budget__.hard && jl &&
+		!jl_mem_shrinking__ && jl_thread_is_main__(jl))
+	{
+		jl_mem_shrink(jl, total - (jl_mem_budget__.soft ?
+			jl_mem_budget__.soft : jl_mem_budget__.hard));
+	}
+}
+
+static inline u32_t jl_mem_rotl__(u32_t x, u8_t k) {
+	return (x << k) | (x >> (32 - k));
+}
+
+// Step a xoshiro128** generator.
+static inline u32_t jl_mem_random_next__(m_u32_t* s) {
+	u32_t result = jl_mem_rotl__(s[1] * 5, 7) * 9;
+	u32_t t = s[1] << 9;
+
+	s[2] ^= s[0];
+	s[3] ^= s[1];
+	s[1] ^= s[2];
+	s[0] ^= s[3];
+	s[2] ^= t;
+	s[3] = jl_mem_rotl__(s[3], 11);
+	return result;
+}
+
+// Seed for the random number generators ( see jl_mem_random_seed() ).
+static m_u64_t jl_mem_random_seed__ = JL_MEM_RANDOM_SEED;
+
+// splitmix64, to expand a seed into generator state.
+static u32_t jl_mem_random_split__(m_u64_t* x) {
+	m_u64_t z = (*x += 0x9E3779B97F4A7C15ull);
+
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+	return (z ^ (z >> 31)) >> 32;
+}
+
+// Allocate "size" bytes that didn't fit in the arena; freed on the next reset.
+static void* jl_mem_frame_spill__(jl_t* jl, jl_ctx_t* ctx, u32_t size) {
+	// The header keeps the list link & the alignment of the returned block.
+	void** spill = jl_mem(jl, NULL, JL_MEM_FRAME_ALIGN + size);
+
+	*spill = ctx->frame.spill;
+	ctx->frame.spill = spill;
+	ctx->frame.over += size;
+	return ((uint8_t*)spill) + JL_MEM_FRAME_ALIGN;
+}
+
+// Free everything spilled, and grow the arena so that it fits next frame.
+static void jl_mem_frame_grow__(jl_t* jl, jl_ctx_t* ctx) {
+	m_u32_t size = ctx->frame.size ? ctx->frame.size : JL_MEM_FRAME_SIZE;
+
+	while(ctx->frame.spill) {
+		void* next = *((void**)ctx->frame.spill);
+
+		jl_mem(jl, ctx->frame.spill, 0);
+		ctx->frame.spill = next;
+	}
+	while(size < ctx->frame.used + ctx->frame.over) size *= 2;
+	if(size != ctx->frame.size) {
+		ctx->frame.data = jl_mem(jl, ctx->frame.data, size);
+		ctx->frame.size = size;
+	}
+	ctx->frame.over = 0;
+}
+
+/** @endcond **/
 
 /**
  * Return Amount Of Total Memory Being Used
- * @returns The total amount of memory being used in bytes.
+ * @returns The total amount of memory allocated through jl_mem() in bytes.
 **/
 u64_t jl_mem_tbiu(void) {
-	struct mallinfo mi;
+	m_i64_t total = 0;
+	uint8_t i;
 
-#if JL_PLAT != JL_PLAT_PHONE
-	malloc_trim(0); //Remove Free Memory
-#endif
-	mi = mallinfo();
-	return mi.uordblks;
+	for(i = 0; i < JL_MEM_TAG_MAX; i++)
+		total += __atomic_load_n(&jl_mem_bytes__[i], __ATOMIC_RELAXED);
+	return total;
+}
+
+/**
+ * Get a snapshot of how much memory is in use for each subsystem.  A block
+ *	that's freed by a different subsystem than the one that allocated it
+ *	moves it's bytes between the tags, but the totals are always exact.
+ * @param stats: Where to save the snapshot.
+**/
+void jl_mem_stats(jl_mem_stats_t* stats) {
+	uint8_t i;
+
+	stats->total_bytes = 0;
+	stats->total_count = 0;
+	SDL_AtomicLock(&jl_mem_budget__.lock);
+	stats->shrinks = jl_mem_budget__.shrinks;
+	stats->shrunk = jl_mem_budget__.shrunk;
+	SDL_AtomicUnlock(&jl_mem_budget__.lock);
+	for(i = 0; i < JL_MEM_TAG_MAX; i++) {
+		stats->bytes[i] =
+			__atomic_load_n(&jl_mem_bytes__[i], __ATOMIC_RELAXED);
+		stats->count[i] =
+			__atomic_load_n(&jl_mem_count__[i], __ATOMIC_RELAXED);
+		stats->total_bytes += stats->bytes[i];
+		stats->total_count += stats->count[i];
+	}
+}
+
+/**
+ * Set the memory budget.  When memory use goes over "soft", registered shrink
+ * callbacks run at the end of the frame, and per-frame buffers are trimmed.
+ * When it goes over "hard" ( or an allocation fails ), they run right away.
+ * @param jl: The library context.
+ * @param soft: Soft limit in bytes, 0 for none.
+ * @param hard: Hard limit in bytes, 0 for none.
+**/
+void jl_mem_budget(jl_t* jl, u64_t soft, u64_t hard) {
+	jl_mem_budget__.jl = jl;
+	jl_mem_budget__.soft = soft;
+	jl_mem_budget__.hard = hard;
+	SDL_AtomicSet(&jl_mem_budget__.pending, 0);
+}
+
+/**
+ * Register a function to release cold cache entries under memory pressure.
+ * Shrink callbacks are only ever called on the main thread.
+ * @param jl: The library context.
+ * @param fn: The callback, which is passed "data" and about how many bytes
+ *	should be freed.  It returns about how many bytes it freed that
+ *	jl_mem_tbiu() doesn't count ( memory other libraries allocated ), or 0
+ *	if it only frees memory from jl_mem().
+ * @param data: Data to pass to "fn".
+**/
+void jl_mem_shrink_add(jl_t* jl, jl_mem_shrink_fnt fn, void* data) {
+	SDL_AtomicLock(&jl_mem_budget__.lock);
+	if(jl_mem_budget__.count == JL_MEM_SHRINK_MAX) {
+		SDL_AtomicUnlock(&jl_mem_budget__.lock);
+		jl_print(jl, "jl_mem_shrink_add(): too many callbacks!");
+		exit(-1);
+	}
+	jl_mem_budget__.fns[jl_mem_budget__.count].fn = fn;
+	jl_mem_budget__.fns[jl_mem_budget__.count].data = data;
+	jl_mem_budget__.count++;
+	SDL_AtomicUnlock(&jl_mem_budget__.lock);
+}
+
+/**
+ * Unregister a function added with jl_mem_shrink_add().
+ * @param jl: The library context.
+ * @param fn: The callback.
+ * @param data: The data it was registered with.
+**/
+void jl_mem_shrink_remove(jl_t* jl, jl_mem_shrink_fnt fn, void* data) {
+	uint8_t i;
+
+	SDL_AtomicLock(&jl_mem_budget__.lock);
+	for(i = 0; i < jl_mem_budget__.count; i++) {
+		if(jl_mem_budget__.fns[i].fn == fn &&
+			jl_mem_budget__.fns[i].data == data)
+		{
+			jl_mem_budget__.count--;
+			jl_mem_budget__.fns[i] =
+				jl_mem_budget__.fns[jl_mem_budget__.count];
+			break;
+		}
+	}
+	SDL_AtomicUnlock(&jl_mem_budget__.lock);
+}
+
+/**
+ * Ask the registered callbacks to free memory, stopping once "bytes" bytes
+ * were freed.  Must be called on the main thread.
+ * @param jl: The library context.
+ * @param bytes: How many bytes to try to free.
+ * @returns: How many bytes were freed ( measured, plus what the callbacks
+ *	say they freed outside of jl_mem() ).
+**/
+u64_t jl_mem_shrink(jl_t* jl, u64_t bytes) {
+	i64_t start = jl_mem_tbiu();
+	m_i64_t freed = 0, other = 0;
+	uint8_t i, count;
+	struct {
+		jl_mem_shrink_fnt fn;
+		void* data;
+	}fns[JL_MEM_SHRINK_MAX];
+
+	if(jl_mem_shrinking__) return 0;
+	jl_mem_shrinking__ = 1;
+	// Copy the callbacks, so they aren't run with the lock held.
+	SDL_AtomicLock(&jl_mem_budget__.lock);
+	count = jl_mem_budget__.count;
+	jl_mem_copyto(jl_mem_budget__.fns, fns, count * sizeof(fns[0]));
+	SDL_AtomicUnlock(&jl_mem_budget__.lock);
+	for(i = 0; i < count && freed < (i64_t)bytes; i++) {
+		other += fns[i].fn(jl, fns[i].data, bytes - freed);
+		freed = start - (i64_t)jl_mem_tbiu() + other;
+	}
+	jl_mem_shrinking__ = 0;
+	if(freed < 0) freed = 0;
+	SDL_AtomicLock(&jl_mem_budget__.lock);
+	jl_mem_budget__.shrinks++;
+	jl_mem_budget__.shrunk += freed;
+	SDL_AtomicUnlock(&jl_mem_budget__.lock);
+	JL_PRINT_DEBUG(jl, "jl_mem_shrink(): freed %ld of %lu bytes",
+		(long)freed, (unsigned long)bytes);
+	return freed;
 }
 
 void jl_mem_leak_init(jl_t* jl) {
@@ -52,21 +374,7 @@ void jl_mem_leak_fail(jl_t* jl, str_t fn_name) {
  * @param size: # of bytes to resize to/allocate, or 0 to free.
 **/
 void *jl_mem(jl_t* jl, void *a, u64_t size) {
-	if(size == 0) { // Free
-		if(a == NULL) {
-			jl_print(jl, "Double Free or free on NULL pointer");
-			exit(-1);
-		}else{
-			free(a);
-		}
-		return NULL;
-	}else{ // Allocate or Resize
-		if((a = realloc(a, size)) == NULL) {
-			jl_print(jl, "realloc() failed! Out of memory?");
-			exit(-1);
-		}
-	}
-	return a;
+	return jl_mem__(jl, a, size, JL_MEM_TAG_USER);
 }
 
 /**
@@ -76,19 +384,7 @@ void *jl_mem(jl_t* jl, void *a, u64_t size) {
  * @param size: # of bytes to allocate.
 **/
 void *jl_memi(jl_t* jl, u64_t size) {
-	// Make sure size is non-zero.
-	if(!size) {
-		if(jl) jl_print(jl, "jl_memi(): size must be more than 0");
-		else JL_PRINT("jl_memi(): size must be more than 0");
-		exit(-1);
-	}
-	// Allocate Memory.
-	void* a = jl_mem(jl, NULL, size);
-
-	// Clear the memory.
-	jl_mem_clr(a, size);
-	// Return the memory
-	return a;
+	return jl_memi__(jl, size, JL_MEM_TAG_USER);
 }
 
 /**
@@ -124,29 +420,160 @@ void *jl_mem_copy(jl_t* jl, const void *src, u64_t size) {
 }
 
 /**
- * Format a string.
+ * Allocate memory aligned to "align" bytes, so SIMD kernels can use aligned
+ * loads.  Free it with jl_mem(), but don't resize it ( resizing may lose the
+ * alignment ).
+ * @param jl: The library context.
+ * @param size: # of bytes to allocate.
+ * @param align: The alignment, a power of 2 ( ex: JL_MEM_ALIGN ).
+ * @returns: The new memory.
+**/
+void *jl_mem_aligned(jl_t* jl, u64_t size, u32_t align) {
+	return jl_mem_aligned__(jl, size, align, JL_MEM_TAG_USER);
+}
+
+/**
+ * Allocate a large buffer ( pixels, vertices, etc. ).  On Linux big blocks are
+ * mapped straight from the OS and backed by huge pages when possible, to cut
+ * TLB misses.  The memory is aligned to JL_MEM_ALIGN bytes, and is not
+ * cleared.  Free it with jl_mem_large_free().
+ * @param jl: The library context.
+ * @param size: # of bytes to allocate.
+ * @returns: The new memory.
+**/
+void *jl_mem_large(jl_t* jl, u64_t size) {
+	return jl_mem_large__(jl, size, JL_MEM_TAG_USER);
+}
+
+/**
+ * Free memory allocated with jl_mem_large().
+ * @param jl: The library context.
+ * @param mem: The memory to free.
+**/
+void jl_mem_large_free(jl_t* jl, void* mem) {
+	jl_mem_large_t* header = (void*)((uint8_t*)mem - JL_MEM_LARGE_HEADER);
+
+#ifdef JL_MEM_LARGE_MMAP
+	if(header->mapped) {
+		jl_mem_count_add__(header->tag, -(m_i64_t)header->size, -1);
+		munmap(header, header->size);
+		return;
+	}
+#endif
+	jl_mem__(jl, header, 0, header->tag);
+}
+
+/**
+ * Format a string into the calling thread's format buffer.  The buffer grows to
+ * fit, so long strings aren't truncated.
+ * @param jl: The library context.
+ * @param format: The format string, followed by it's arguments.
+ * @returns: The formatted string, valid until this thread's next call.
 **/
 str_t jl_mem_format(jl_t* jl, str_t format, ... ) {
 	if(format) {
+		jl_ctx_t* ctx = jl_thread_get_safe__(jl);
 		va_list arglist;
-		void* temp = jl->jl_ctx[jl_thread_current(jl)].temp;
+		str_t rtn;
 
 		va_start( arglist, format );
-		vsprintf( temp, format, arglist );
+		rtn = jl_mem_vformat__(jl, &ctx->format.data, &ctx->format.size,
+			format, arglist);
 		va_end( arglist );
-		return temp;
+		return rtn;
 	}else{
 		return NULL;
 	}
 }
 
 /**
- * Generate a random integer from 0 to "a"
+ * Seed the random number generators of all threads, including threads made
+ * later.  The same seed always gives the same numbers on the same thread ID.
+ * @param jl: The library context.
+ * @param seed: The seed.
+**/
+void jl_mem_random_seed(jl_t* jl, u64_t seed) {
+	m_u16_t i;
+
+	SDL_AtomicLock(&jl->thread_lock);
+	jl_mem_random_seed__ = seed;
+	for(i = 0; i < jl->thread_count; i++)
+		jl_mem_random_init__(jl->jl_ctx[i], i);
+	SDL_AtomicUnlock(&jl->thread_lock);
+}
+
+/**
+ * Generate a random integer from 0 to "a", without modulo bias.
+ * @param jl: The library context.
  * @param a: 1 more than the maximum # to return
  * @returns: a random integer from 0 to "a"
 */
-u32_t jl_mem_random_int(u32_t a) {
-	return rand()%a;
+u32_t jl_mem_random_int(jl_t* jl, u32_t a) {
+	m_u32_t* s = jl_thread_get_safe__(jl)->random.s;
+	m_u64_t m = (u64_t)jl_mem_random_next__(s) * a;
+
+	// Reject the few values that would make low numbers more likely.
+	if((u32_t)m < a) {
+		u32_t threshold = -a % a;
+
+		while((u32_t)m < threshold)
+			m = (u64_t)jl_mem_random_next__(s) * a;
+	}
+	return m >> 32;
+}
+
+/**
+ * Generate a random float from 0 to 1 ( never 1 ).
+ * @param jl: The library context.
+ * @returns: a random float in [0, 1).
+*/
+f32_t jl_mem_random_float(jl_t* jl) {
+	m_u32_t* s = jl_thread_get_safe__(jl)->random.s;
+
+	return (jl_mem_random_next__(s) >> 8) * (1.f / 16777216.f);
+}
+
+/**
+ * Fill an array with random integers.  Runs 4 generators side by side, so the
+ * compiler can vectorize the loop.
+ * @param jl: The library context.
+ * @param buffer: The array to fill.
+ * @param count: How many integers to write to "buffer".
+*/
+void jl_mem_random_fill(jl_t* jl, m_u32_t* buffer, u32_t count) {
+	jl_ctx_t* ctx = jl_thread_get_safe__(jl);
+	m_u32_t s0[4], s1[4], s2[4], s3[4];
+	m_u32_t i = 0, j;
+
+	// Work on local copies so they can stay in registers.
+	for(j = 0; j < 4; j++) {
+		s0[j] = ctx->random.lane[0][j];
+		s1[j] = ctx->random.lane[1][j];
+		s2[j] = ctx->random.lane[2][j];
+		s3[j] = ctx->random.lane[3][j];
+	}
+	for(i = 0; i + 4 <= count; i += 4) {
+		for(j = 0; j < 4; j++) {
+			u32_t t = s1[j] << 9;
+
+			buffer[i + j] = jl_mem_rotl__(s1[j] * 5, 7) * 9;
+			s2[j] ^= s0[j];
+			s3[j] ^= s1[j];
+			s1[j] ^= s2[j];
+			s0[j] ^= s3[j];
+			s2[j] ^= t;
+			s3[j] = jl_mem_rotl__(s3[j], 11);
+		}
+	}
+	for(j = 0; j < 4; j++) {
+		ctx->random.lane[0][j] = s0[j];
+		ctx->random.lane[1][j] = s1[j];
+		ctx->random.lane[2][j] = s2[j];
+		ctx->random.lane[3][j] = s3[j];
+	}
+	// Fill the last few with the scalar generator.
+	for(; i < count; i++)
+		buffer[i] = jl_mem_random_next__(ctx->random.s);
 }
 
 /**
@@ -157,12 +584,137 @@ u32_t jl_mem_random_int(u32_t a) {
  * @returns: The old/previous value of the pointer.
 **/
 void *jl_mem_temp(jl_t* jl, void *mem) {
-	void* rtn = jl->jl_ctx[jl_thread_current(jl)].temp_ptr;
+	void* rtn = jl_thread_get_safe__(jl)->temp_ptr;
 
-	jl->jl_ctx[jl_thread_current(jl)].temp_ptr = mem;
+	jl_thread_get_safe__(jl)->temp_ptr = mem;
 	return rtn;
 }
 
+/**
+ * Allocate scratch memory that lives until the end of the current frame.  Each
+ * thread has it's own arena, which is reset all at once by
+ * jl_mem_frame_reset() ( main thread: after the mode loop, draw thread: after
+ * the screen is updated ).  Don't free memory returned by this function.
+ * @param jl: The library context.
+ * @param size: # of bytes to allocate.
+ * @returns: Uninitialized memory aligned to JL_MEM_FRAME_ALIGN bytes.
+**/
+void *jl_mem_frame_alloc(jl_t* jl, u32_t size) {
+	jl_ctx_t* ctx = jl_thread_get_safe__(jl);
+	u32_t aligned = (size + (JL_MEM_FRAME_ALIGN - 1)) &
+		~(JL_MEM_FRAME_ALIGN - 1);
+	void* rtn;
+
+	// Make the arena on first use.
+	if(ctx->frame.data == NULL) jl_mem_frame_grow__(jl, ctx);
+	// If it doesn't fit this frame, spill over until the next reset.
+	if(aligned > ctx->frame.size - ctx->frame.used)
+		return jl_mem_frame_spill__(jl, ctx, aligned);
+	rtn = ctx->frame.data + ctx->frame.used;
+	ctx->frame.used += aligned;
+	return rtn;
+}
+
+/**
+ * Release all memory from jl_mem_frame_alloc() on the current thread.  In
+ * debug mode, the old frame is filled with JL_MEM_FRAME_POISON, so that uses
+ * after the frame ended are easy to spot.
+ * @param jl: The library context.
+**/
+void jl_mem_frame_reset(jl_t* jl) {
+	jl_ctx_t* ctx = jl_thread_get_safe__(jl);
+
+#ifdef DEBUG
+	if(ctx->frame.data)
+		memset(ctx->frame.data, JL_MEM_FRAME_POISON, ctx->frame.used);
+#endif
+	// Only happens when a frame needed more than the arena had.
+	if(ctx->frame.spill) jl_mem_frame_grow__(jl, ctx);
+	ctx->frame.used = 0;
+	// Under memory pressure, drop buffers that grew past their start size.
+	if(jl_mem_budget__.soft && jl_mem_tbiu() > jl_mem_budget__.soft) {
+		if(ctx->frame.size > JL_MEM_FRAME_SIZE) {
+			ctx->frame.data = jl_mem(jl, ctx->frame.data, 0);
+			ctx->frame.size = 0;
+		}
+		if(ctx->format.size > JL_MEM_FORMAT_SIZE) {
+			ctx->format.data = jl_mem(jl, ctx->format.data, 0);
+			ctx->format.size = 0;
+		}
+		if(ctx->log.size > JL_MEM_FORMAT_SIZE) {
+			ctx->log.data = jl_mem(jl, ctx->log.data, 0);
+			ctx->log.size = 0;
+		}
+	}
+}
+
+/**
+ * Print which call sites allocate the most memory, how big the allocations
+ *	are and how many allocations happen each frame.  Only works if
+ *	JL_MEM_PROFILE is defined in "jl_me.h".  This is also printed when
+ *	JL_Lib quits.
+ * @param jl: The library context.
+**/
+void jl_mem_profile_print(jl_t* jl) {
+#ifdef JL_MEM_PROFILE
+	jl_mem_site_t sites[JL_MEM_PROFILE_SITES];
+	m_u64_t sizes[32];
+	m_u64_t frames, allocs, peak;
+	m_u32_t i, used = 0;
+
+	// Take a snapshot, so printing doesn't hold the lock.
+	SDL_AtomicLock(&jl_mem_profile_lock__);
+	for(i = 0; i < JL_MEM_PROFILE_SITES; i++) {
+		if(jl_mem_profile_sites__[i].file)
+			sites[used++] = jl_mem_profile_sites__[i];
+	}
+	jl_mem_copyto(jl_mem_profile_sizes__, sizes, sizeof(sizes));
+	frames = jl_mem_profile_rate__.frames;
+	allocs = jl_mem_profile_rate__.allocs;
+	peak = jl_mem_profile_rate__.peak;
+	SDL_AtomicUnlock(&jl_mem_profile_lock__);
+	qsort(sites, used, sizeof(jl_mem_site_t), jl_mem_profile_cmp__);
+	// Print the report.
+	jl_print(jl, "Allocations: %llu in %llu frames, %.1f/frame, peak %llu",
+		(unsigned long long)allocs, (unsigned long long)frames,
+		frames ? ((double)allocs) / frames : 0.,
+		(unsigned long long)peak);
+	for(i = 0; i < used && i < JL_MEM_PROFILE_SHOW; i++) {
+		jl_print(jl, "%10llu bytes %8llu allocs %s:%d",
+			(unsigned long long)sites[i].bytes,
+			(unsigned long long)sites[i].count,
+			sites[i].file, sites[i].line);
+	}
+	for(i = 0; i < 32; i++) {
+		if(sizes[i]) jl_print(jl, "Size %10llu+: %llu allocs",
+			((unsigned long long)1) << i,
+			(unsigned long long)sizes[i]);
+	}
+#else
+	jl_print(jl, "jl_mem_profile_print(): JL_MEM_PROFILE isn't defined");
+#endif
+}
+
+/**
+ * Set the call site for the allocation in progress on this thread.  Used by
+ *	the JL_MEM_SITE() macro - the outermost call site wins.
+ * @param file: The source file, or NULL to clear the call site.
+ * @param line: The line number in "file".
+ * @returns: 1 if the call site was set, 0 if not.
+**/
+u8_t jl_mem_site__(str_t file, i32_t line) {
+#ifdef JL_MEM_PROFILE
+	if(file == NULL) {
+		jl_mem_site_file__ = NULL;
+	}else if(jl_mem_site_file__ == NULL) {
+		jl_mem_site_file__ = file;
+		jl_mem_site_line__ = line;
+		return 1;
+	}
+#endif
+	return 0;
+}
+
 jvct_t* jl_mem_init__(void) {
 	//Create a context for the currently loaded program
 	jvct_t* _jl = jl_memi(NULL, sizeof(jvct_t));
@@ -179,10 +731,177 @@ jvct_t* jl_mem_init__(void) {
 	_jl->has.filesys = 0;
 	_jl->has.input = 0;
 	_jl->me.status = JL_STATUS_GOOD;
+	jl_mem_budget__.jl = _jl->jl;
 	return _jl;
 }
 
+void *jl_mem__(jl_t* jl, void *a, u64_t size, jl_mem_tag_t tag) {
+	if(size == 0) { // Free
+		if(a == NULL) {
+			jl_print(jl, "Double Free or free on NULL pointer");
+			exit(-1);
+		}else{
+			jl_mem_count_add__(tag, -(m_i64_t)malloc_usable_size(a), -1);
+			free(a);
+		}
+		return NULL;
+	}else{ // Allocate or Resize
+		m_i64_t old_size = a ? malloc_usable_size(a) : 0;
+		m_i64_t new_count = a ? 0 : 1;
+
+		void* b;
+
+		if(jl == NULL) jl = jl_mem_budget__.jl;
+		// If out of memory, shed caches and try again before quitting.
+		if((b = realloc(a, size)) == NULL && jl && !jl_mem_shrinking__
+			&& jl_thread_is_main__(jl))
+		{
+			jl_mem_shrink(jl, size);
+			b = realloc(a, size);
+		}
+		if((a = b) == NULL) {
+			jl_print(jl, "realloc() failed! Out of memory?");
+			exit(-1);
+		}
+		jl_mem_count_add__(tag, malloc_usable_size(a) - old_size,
+			new_count);
+#ifdef JL_MEM_PROFILE
+		jl_mem_profile_add__(size);
+#endif
+		jl_mem_budget_check__(jl);
+	}
+	return a;
+}
+
+void jl_mem_pressure__(jl_t* jl) {
+	if(!SDL_AtomicSet(&jl_mem_budget__.pending, 0)) return;
+	if(jl_mem_tbiu() > jl_mem_budget__.soft)
+		jl_mem_shrink(jl, jl_mem_tbiu() - jl_mem_budget__.soft);
+}
+
+void jl_mem_profile_frame__(void) {
+#ifdef JL_MEM_PROFILE
+	SDL_AtomicLock(&jl_mem_profile_lock__);
+	if(jl_mem_profile_rate__.frame > jl_mem_profile_rate__.peak)
+		jl_mem_profile_rate__.peak = jl_mem_profile_rate__.frame;
+	jl_mem_profile_rate__.frame = 0;
+	jl_mem_profile_rate__.frames++;
+	SDL_AtomicUnlock(&jl_mem_profile_lock__);
+#endif
+}
+
+void *jl_memi__(jl_t* jl, u64_t size, jl_mem_tag_t tag) {
+	// Make sure size is non-zero.
+	if(!size) {
+		if(jl) jl_print(jl, "jl_memi(): size must be more than 0");
+		else JL_PRINT("jl_memi(): size must be more than 0");
+		exit(-1);
+	}
+	// Allocate Memory.
+	void* a = jl_mem__(jl, NULL, size, tag);
+
+	// Clear the memory.
+	jl_mem_clr(a, size);
+	// Return the memory
+	return a;
+}
+
+void *jl_mem_aligned__(jl_t* jl, u64_t size, u32_t align, jl_mem_tag_t tag) {
+	void* a = NULL;
+
+	// posix_memalign() needs at least pointer alignment.
+	if(posix_memalign(&a, align < sizeof(void*) ? sizeof(void*) : align,
+		size ? size : 1))
+	{
+		jl_print(jl, "posix_memalign() failed! Out of memory?");
+		exit(-1);
+	}
+	jl_mem_count_add__(tag, malloc_usable_size(a), 1);
+#ifdef JL_MEM_PROFILE
+	jl_mem_profile_add__(size);
+#endif
+	return a;
+}
+
+void *jl_mem_large__(jl_t* jl, u64_t size, jl_mem_tag_t tag) {
+	u64_t total = size + JL_MEM_LARGE_HEADER;
+	jl_mem_large_t* header = NULL;
+
+#ifdef JL_MEM_LARGE_MMAP
+	if(total >= JL_MEM_LARGE_MIN) {
+		header = mmap(NULL, total, PROT_READ | PROT_WRITE,
+			MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if(header == MAP_FAILED) {
+			jl_print(jl, "mmap() failed! Out of memory?");
+			exit(-1);
+		}
+	#ifdef MADV_HUGEPAGE
+		// Only a hint: fine if huge pages aren't available.
+		madvise(header, total, MADV_HUGEPAGE);
+	#endif
+		header->mapped = 1;
+		jl_mem_count_add__(tag, total, 1);
+	#ifdef JL_MEM_PROFILE
+		jl_mem_profile_add__(size);
+	#endif
+	}
+#endif
+	if(header == NULL) {
+		header = jl_mem_aligned__(jl, total, JL_MEM_ALIGN, tag);
+		header->mapped = 0;
+	}
+	header->size = total;
+	header->tag = tag;
+	return (uint8_t*)header + JL_MEM_LARGE_HEADER;
+}
+
+str_t jl_mem_vformat__(jl_t* jl, char** buffer, m_u32_t* size,
+	str_t format, va_list arglist)
+{
+	va_list args;
+	int len;
+
+	// Try to format into the buffer as it is.
+	va_copy(args, arglist);
+	len = vsnprintf(*buffer, *size, format, args);
+	va_end(args);
+	if(len < 0) return "";
+	// Didn't fit: grow the buffer and format again.
+	if(len >= *size) {
+		m_u32_t newsize = *size ? *size : JL_MEM_FORMAT_SIZE;
+
+		while(newsize <= len) newsize *= 2;
+		*buffer = jl_mem__(jl, *buffer, newsize, JL_MEM_TAG_USER);
+		*size = newsize;
+		va_copy(args, arglist);
+		vsnprintf(*buffer, *size, format, args);
+		va_end(args);
+	}
+	return *buffer;
+}
+
+// Seed a thread's random number generators from it's thread ID.
+void jl_mem_random_init__(jl_ctx_t* ctx, u16_t id) {
+	m_u64_t x = jl_mem_random_seed__ + id * 0xD1B54A32D192ED03ull;
+	uint8_t j, k;
+
+	for(j = 0; j < 4; j++) {
+		ctx->random.s[j] = jl_mem_random_split__(&x);
+		for(k = 0; k < 4; k++)
+			ctx->random.lane[j][k] = jl_mem_random_split__(&x);
+	}
+}
+
+// Free a thread context's per-frame arena & format buffers.
+void jl_mem_ctx_free__(jl_t* jl, jl_ctx_t* ctx) {
+	ctx->frame.used = ctx->frame.over = 0;
+	if(ctx->frame.spill) jl_mem_frame_grow__(jl, ctx);
+	if(ctx->frame.data) jl_mem(jl, ctx->frame.data, 0);
+	if(ctx->format.data) jl_mem(jl, ctx->format.data, 0);
+	if(ctx->log.data) jl_mem(jl, ctx->log.data, 0);
+}
+
 void jl_mem_kill__(jvct_t* _jl) {
-	free(_jl);
+	jl_mem(_jl->jl, _jl, 0);
 //	cl_list_destroy(g_vmap_list);
 }
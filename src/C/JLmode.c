@@ -87,9 +87,25 @@ void jl_mode_switch(jl_t* jl, u16_t mode) {
 	jl->mode.which = mode;
 	// Update mode functions
 	jl_mode_reset(jl);
-	// Run the new mode's init functions.
+	// Run the new mode's init functions ( until it finishes or yields ).
 	init_ = jl->mode.mode.init;
+	jl->mode.resume = 0;
 	init_(jl);
+	jl->mode.initing = jl->mode.resume != 0;
+}
+
+/**
+ * Check if this frame's time for work is used up, so a yielding init or loop
+ * can spread work over frames without dropping the frame rate:
+ *	while(ctx->loaded < ctx->count) {
+ *		load_one(jl, ctx->loaded++);
+ *		if(jl_mode_time_up(jl)) JL_MODE_YIELD(jl);
+ *	}
+ * @param jl: The library context.
+ * @returns: 1 if JL_MODE_BUDGET milliseconds passed since the frame started.
+ */
+u8_t jl_mode_time_up(jl_t* jl) {
+	return SDL_GetTicks() - jl->time.this_tick >= JL_MODE_BUDGET;
 }
 
 /**
@@ -109,10 +125,24 @@ void jl_mode_exit(jl_t* jl) {
 
 // Internal functions
 
+// Run the mode's loop, or continue it's init if that yielded.
+void jl_mode_loop__(jl_t* jl) {
+	jl_fnct loop_ = jl->mode.initing ? jl->mode.mode.init :
+		jl->mode.mode.loop;
+	u16_t which = jl->mode.which;
+
+	loop_(jl);
+	// Stop continuing the init once it reaches JL_MODE_END().
+	if(jl->mode.initing && which == jl->mode.which)
+		jl->mode.initing = jl->mode.resume != 0;
+}
+
 void jl_mode_init__(jl_t* jl) {
 	// Set up modes:
 	jl->mode.which = 0;
 	jl->mode.count = 0;
+	jl->mode.resume = 0;
+	jl->mode.initing = 0;
 	jl->mode.mdes = NULL;
 	_jl_mode_add(jl);
 	// Clear User Loops
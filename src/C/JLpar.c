@@ -0,0 +1,280 @@
+/*
+ * JL_Lib
+ * Copyright (c) 2015 Jeron A. Lau
+*/
+/** \file
+ * JLpar.c
+ *	Parallel loops, transforms, reductions & sorts on the job workers ( see
+ *	JLjob.c ).  A range is cut into chunks, which the calling thread & the
+ *	workers take 1 at a time until they're gone, so a slow chunk doesn't
+ *	hold up the rest.  Small ranges run on the calling thread.
+**/
+#include "jl_pr.h"
+
+// A range being run by jl_par_for().
+typedef struct{
+	jl_par_fnt fn;
+	void* data;
+	m_u32_t count;
+	m_u32_t grain;
+	m_u32_t chunks;
+	SDL_atomic_t next;	// The next chunk to take.
+}jl_par_range_t;
+
+typedef struct{
+	jl_par_map_fnt fn;
+	void* data;
+	const uint8_t* src;
+	uint8_t* dst;
+	m_u32_t src_size;
+	m_u32_t dst_size;
+}jl_par_transform_t;
+
+typedef struct{
+	jl_par_reduce_fnt fn;
+	void* data;
+	const uint8_t* src;
+	uint8_t* partials;	// 1 result for each chunk
+	m_u32_t size;
+	m_u32_t grain;
+}jl_par_reduction_t;
+
+typedef struct{
+	jl_par_cmp_fnt cmp;
+	uint8_t* src;
+	uint8_t* dst;
+	m_u32_t count;
+	m_u32_t size;
+	m_u32_t runs;
+	m_u32_t width;		// Runs in each sorted half, when merging.
+}jl_par_sorting_t;
+
+//
+// Internal Functions
+//
+
+// Take chunks until there are none left.
+static void jl_par_range_run__(jl_t* jl, void* data) {
+	jl_par_range_t* range = data;
+	m_u32_t chunk;
+
+	while((chunk = SDL_AtomicAdd(&range->next, 1)) < range->chunks) {
+		u32_t start = chunk * range->grain;
+		u32_t end = start + range->grain;
+
+		range->fn(jl, range->data, start,
+			end < range->count ? end : range->count);
+	}
+}
+
+// The grain to use when the caller doesn't pick one ( 0 = run serially ).
+static u32_t jl_par_grain__(jl_t* jl, u32_t count) {
+	u32_t threads = jl_job_workers(jl) + 1;
+	m_u32_t grain = count / (threads * JL_PAR_SPLIT);
+
+	if(count < JL_PAR_SERIAL || threads == 1) return 0;
+	return grain < JL_PAR_GRAIN ? JL_PAR_GRAIN : grain;
+}
+
+static void jl_par_transform__(jl_t* jl, void* data, u32_t start, u32_t end) {
+	jl_par_transform_t* map = data;
+	m_u32_t i;
+
+	for(i = start; i < end; i++) {
+		map->fn(jl, map->data, map->src + i * map->src_size,
+			map->dst + i * map->dst_size);
+	}
+}
+
+static void jl_par_reduce__(jl_t* jl, void* data, u32_t start, u32_t end) {
+	jl_par_reduction_t* reduction = data;
+	uint8_t* acc = reduction->partials +
+		(start / reduction->grain) * reduction->size;
+	m_u32_t i;
+
+	for(i = start; i < end; i++) {
+		reduction->fn(jl, reduction->data, acc,
+			reduction->src + i * reduction->size);
+	}
+}
+
+// Where run "run" starts.
+static inline u32_t jl_par_run__(jl_par_sorting_t* sort, u32_t run) {
+	return ((u64_t)sort->count * run) / sort->runs;
+}
+
+static void jl_par_sort_run__(jl_t* jl, void* data, u32_t start, u32_t end) {
+	jl_par_sorting_t* sort = data;
+	m_u32_t i;
+
+	for(i = start; i < end; i++) {
+		u32_t a = jl_par_run__(sort, i);
+
+		qsort(sort->src + a * sort->size, jl_par_run__(sort, i + 1) - a,
+			sort->size, sort->cmp);
+	}
+}
+
+static void jl_par_sort_merge__(jl_t* jl, void* data, u32_t start, u32_t end) {
+	jl_par_sorting_t* sort = data;
+	u32_t size = sort->size;
+	m_u32_t i;
+
+	for(i = start; i < end; i++) {
+		u32_t first = i * 2 * sort->width;
+		m_u32_t a = jl_par_run__(sort, first);
+		u32_t mid = jl_par_run__(sort, first + sort->width);
+		m_u32_t b = mid;
+		u32_t last = jl_par_run__(sort, first + 2 * sort->width);
+		uint8_t* out = sort->dst + a * size;
+
+		// Take from the 1st half on ties, to keep the runs in order.
+		while(a < mid && b < last) {
+			if(sort->cmp(sort->src + b * size, sort->src + a*size) < 0){
+				jl_mem_copyto(sort->src + b * size, out, size);
+				b++;
+			}else{
+				jl_mem_copyto(sort->src + a * size, out, size);
+				a++;
+			}
+			out += size;
+		}
+		jl_mem_copyto(sort->src + a * size, out, (mid - a) * size);
+		out += (mid - a) * size;
+		jl_mem_copyto(sort->src + b * size, out, (last - b) * size);
+	}
+}
+
+//
+// Exported Functions
+//
+
+/**
+ * Run "fn" over the range 0 to "count", split across the job workers.  Each
+ * call of "fn" gets a part of the range.  Returns when all of it is done.
+ * @param jl: The library context.
+ * @param count: The size of the range.
+ * @param grain: How much of the range each call of "fn" gets, 0 to pick one
+ *	from the range & core count ( small ranges run on this thread ).
+ * @param fn: The function run on each part.
+ * @param data: Passed to "fn".
+**/
+void jl_par_for(jl_t* jl, u32_t count, u32_t grain, jl_par_fnt fn,
+	void* data)
+{
+	jl_par_range_t range;
+	jl_job_counter_t counter;
+	m_u32_t i, helpers;
+
+	range.grain = grain ? grain : jl_par_grain__(jl, count);
+	if(range.grain == 0 || count <= range.grain || jl_job_workers(jl) == 0)
+	{
+		if(count) fn(jl, data, 0, count);
+		return;
+	}
+	range.fn = fn;
+	range.data = data;
+	range.count = count;
+	range.chunks = (count + range.grain - 1) / range.grain;
+	SDL_AtomicSet(&range.next, 0);
+	SDL_AtomicSet(&counter.count, 0);
+	// No more helpers than there are chunks for them to take.
+	helpers = jl_job_workers(jl);
+	if(helpers > range.chunks - 1) helpers = range.chunks - 1;
+	for(i = 0; i < helpers; i++)
+		jl_job_run(jl, jl_par_range_run__, &range, &counter);
+	jl_par_range_run__(jl, &range);
+	jl_job_wait(jl, &counter);
+}
+
+/**
+ * Run "fn" on each element of "src", writing to the same element of "dst".
+ * @param jl: The library context.
+ * @param src: The input array.
+ * @param dst: The output array ( may be the same as "src" ).
+ * @param count: How many elements are in "src" & "dst".
+ * @param src_size: The size of each element of "src".
+ * @param dst_size: The size of each element of "dst".
+ * @param fn: The function run on each element.
+ * @param data: Passed to "fn".
+**/
+void jl_par_transform(jl_t* jl, const void* src, void* dst, u32_t count,
+	u32_t src_size, u32_t dst_size, jl_par_map_fnt fn, void* data)
+{
+	jl_par_transform_t map = { fn, data, src, dst, src_size, dst_size };
+
+	jl_par_for(jl, count, 0, jl_par_transform__, &map);
+}
+
+/**
+ * Combine all elements of "src" into "result".  Each part of the range is
+ * combined separately, starting from the value in "result", then the parts
+ * are combined in order, so "fn" must be associative & "result" must start as
+ * it's identity ( ex: 0 for +, 1 for * ).
+ * @param jl: The library context.
+ * @param src: The input array.
+ * @param count: How many elements are in "src".
+ * @param size: The size of each element & of "result".
+ * @param result: The identity value in, the combined value out.
+ * @param fn: Combines an element into an accumulator.
+ * @param data: Passed to "fn".
+**/
+void jl_par_reduce(jl_t* jl, const void* src, u32_t count, u32_t size,
+	void* result, jl_par_reduce_fnt fn, void* data)
+{
+	jl_par_reduction_t reduction = { fn, data, src, NULL, size, 0 };
+	m_u32_t i, chunks;
+
+	reduction.grain = jl_par_grain__(jl, count);
+	if(reduction.grain == 0 || jl_job_workers(jl) == 0) {
+		for(i = 0; i < count; i++)
+			fn(jl, data, result, (const uint8_t*)src + i * size);
+		return;
+	}
+	chunks = (count + reduction.grain - 1) / reduction.grain;
+	reduction.partials = jl_mem(jl, NULL, chunks * size);
+	for(i = 0; i < chunks; i++)
+		jl_mem_copyto(result, reduction.partials + i * size, size);
+	jl_par_for(jl, count, reduction.grain, jl_par_reduce__, &reduction);
+	for(i = 0; i < chunks; i++)
+		fn(jl, data, result, reduction.partials + i * size);
+	jl_mem(jl, reduction.partials, 0);
+}
+
+/**
+ * Sort an array: parts are sorted with qsort() on the job workers, then
+ * merged together.  Small arrays are just sorted with qsort().
+ * @param jl: The library context.
+ * @param base: The array to sort.
+ * @param count: How many elements are in "base".
+ * @param size: The size of each element.
+ * @param cmp: Compares 2 elements, like for qsort().
+**/
+void jl_par_sort(jl_t* jl, void* base, u32_t count, u32_t size,
+	jl_par_cmp_fnt cmp)
+{
+	u32_t threads = jl_job_workers(jl) + 1;
+	jl_par_sorting_t sort = { cmp, base, NULL, count, size, 1, 0 };
+	uint8_t* swap;
+
+	if(count < JL_PAR_SERIAL || threads == 1) {
+		qsort(base, count, size, cmp);
+		return;
+	}
+	// A power of 2 runs, about 2 for each thread, so merges pair up.
+	while(sort.runs < threads * 2 && count / (sort.runs * 2) >=
+		JL_PAR_GRAIN) sort.runs *= 2;
+	jl_par_for(jl, sort.runs, 1, jl_par_sort_run__, &sort);
+	// Merge pairs of sorted runs, back & forth between "base" & "tmp".
+	sort.dst = jl_mem(jl, NULL, (u64_t)count * size);
+	for(sort.width = 1; sort.width < sort.runs; sort.width *= 2) {
+		jl_par_for(jl, sort.runs / (2 * sort.width), 1,
+			jl_par_sort_merge__, &sort);
+		swap = sort.src, sort.src = sort.dst, sort.dst = swap;
+	}
+	if(sort.src != base) {
+		jl_mem_copyto(sort.src, base, (u64_t)count * size);
+		sort.dst = sort.src;
+	}
+	jl_mem(jl, sort.dst, 0);
+}
@@ -5,117 +5,283 @@
 /** \file
  * JLprint.c
  *	is a library for printing to various terminals and creating a stack
- *	trace.
+ *	trace.  Each thread queues it's lines on it's own ring, without
+ *	locking, and a writer thread sends them to the console, the log file
+ *	and any sinks.  If a ring is full, the line is dropped and counted.
 **/
 
 #include "jl_pr.h"
 
-static void _jl_print_current(jl_t *jl, u8_t thread_id) {
-	int i;
+// A line, as queued for the writer thread.
+typedef struct{
+	m_u32_t len;			// Length of "text"
+	char text[JL_PRINT_LINE];	// The line ( NUL terminated )
+}jl_print_line_t;
+
+static struct {
+	jl_t* jl;		// For flushing at exit().
+	SDL_atomic_t running;	// Set while the writer thread runs.
+	SDL_atomic_t quit;	// Set to stop the writer thread.
+	SDL_atomic_t sleeping;	// Set while the writer thread waits.
+	SDL_atomic_t dropped;	// Lines dropped because a ring was full.
+	SDL_sem* wake;		// Posted when the writer thread is sleeping.
+	m_u16_t thread;		// The writer thread's ID.
+	// Everything below is only used while holding "mutex".  It's a mutex,
+	// not a spinlock, because it's held while writing files & running
+	// sinks ( & SDL's mutexes are recursive ).
+	SDL_mutex* mutex;
+	m_i32_t reported;	// "dropped" when it was last printed.
+	FILE* file;		// The log file ( opened when first written ).
+	m_u32_t file_size;	// Bytes in "file".
+	m_str_t file_old;	// Where "file" is moved when it's full.
+	m_u8_t file_done;	// Set once the log file is closed for good.
+	jl_print_fnt sinks[JL_PRINT_SINKS]; // Functions that get every line.
+	m_u8_t sink_count;	// How many functions are in "sinks".
+}jl_print__;
+
+// Lock "mutex" ( there's none after jl_print_kill__(), only 1 thread is left ).
+static void jl_print_lock__(jl_t* jl) {
+	if(jl_print__.mutex) jl_thread_mutex_lock(jl, jl_print__.mutex);
+}
+
+static void jl_print_unlock__(jl_t* jl) {
+	if(jl_print__.mutex) jl_thread_mutex_unlock(jl, jl_print__.mutex);
+}
+
+// Add text to a line, cutting it off if it doesn't fit.
+static void jl_print_add__(jl_print_line_t* line, str_t format, ...) {
+	va_list arglist;
+	int len;
 
-	JL_PRINT(" <");
-	for(i = 0; i < jl->jl_ctx[thread_id].print.level; i++) {
-		JL_PRINT("%s", jl->jl_ctx[thread_id].print.stack[i+1]);
-		JL_PRINT("/");
+	va_start( arglist, format );
+	len = vsnprintf(line->text + line->len, JL_PRINT_LINE - line->len,
+		format, arglist);
+	va_end( arglist );
+	if(len > 0) line->len += len;
+	if(line->len >= JL_PRINT_LINE) line->len = JL_PRINT_LINE - 1;
+}
+
+// Write a line to the log file, keeping 1 old file when it gets too big.
+static void jl_print_file__(jl_t* jl, jl_print_line_t* line) {
+	jvct_t *_jl = jl->_jl;
+	str_t errf;
+
+	if(jl_print__.file_done || !_jl->has.filesys) return;
+	// "errf" is set before "has.filesys" ( see jl_file_init__() ).
+	SDL_MemoryBarrierAcquire();
+	errf = _jl->fl.paths.errf;
+	if(jl_print__.file == NULL) {
+		if(!errf) return;
+		if((jl_print__.file = fopen(errf, "a")) == NULL) return;
+		jl_print__.file_size = ftell(jl_print__.file);
+		if(jl_print__.file_old == NULL) {
+			jl_print__.file_old = jl_memi(jl, strlen(errf) + 5);
+			jl_mem_copyto(errf, jl_print__.file_old, strlen(errf));
+			jl_mem_copyto(".old", jl_print__.file_old +
+				strlen(errf), 4);
+		}
+	}
+	fwrite(line->text, 1, line->len, jl_print__.file);
+	jl_print__.file_size += line->len;
+	if(jl_print__.file_size >= JL_PRINT_FILE_MAX) {
+		fclose(jl_print__.file);
+		jl_print__.file = NULL;
+		rename(errf, jl_print__.file_old);
 	}
-	JL_PRINT("\b>\n");
 }
 
-static void jl_print_indent__(jl_t *jl, i8_t o, u8_t thread_id) {
+// Send a line to the console, the log file & the sinks ( "mutex" is held ).
+static void jl_print_out__(jl_t* jl, jl_print_line_t* line) {
+	jl_print_fnt print_out_ = jl->print.printfn;
+	m_u8_t i;
+
+	print_out_(jl, line->text);
+	jl_print_file__(jl, line);
+	for(i = 0; i < jl_print__.sink_count; i++)
+		jl_print__.sinks[i](jl, line->text);
+}
+
+// Write all queued lines.  Any thread may drain, but only 1 at a time.
+static void jl_print_drain__(jl_t* jl) {
+	jl_print_line_t line;
+	jl_comm_t* ring;
+	m_i32_t dropped;
+	m_u16_t i;
+
+	jl_print_lock__(jl);
+	for(i = 0; ; i++) {
+		// The contexts stay put, but the array of them may move.
+		SDL_AtomicLock(&jl->thread_lock);
+		if(i >= jl->thread_count) {
+			SDL_AtomicUnlock(&jl->thread_lock);
+			break;
+		}
+		ring = SDL_AtomicGetPtr((void**)&jl->jl_ctx[i]->print_ring);
+		SDL_AtomicUnlock(&jl->thread_lock);
+		if(ring == NULL) continue;
+		// Don't read the ring before it's made.
+		SDL_MemoryBarrierAcquire();
+		while(jl_thread_comm_recv_batch(jl, ring, &line, 1))
+			jl_print_out__(jl, &line);
+	}
+	// Say how many lines were lost since last time.
+	dropped = SDL_AtomicGet(&jl_print__.dropped);
+	if(dropped != jl_print__.reported) {
+		line.len = 0;
+		jl_print_add__(&line, "[JL_Lib] Dropped %d lines ( %d total )\n",
+			dropped - jl_print__.reported, dropped);
+		jl_print__.reported = dropped;
+		jl_print_out__(jl, &line);
+	}
+	if(jl_print__.file) fflush(jl_print__.file);
+	jl_print_unlock__(jl);
+}
+
+static int jl_print_writer__(void* data) {
+	jl_t* jl = data;
+
+	while(!SDL_AtomicGet(&jl_print__.quit)) {
+		jl_print_drain__(jl);
+		// Say it's going to sleep, then drain what came in before that.
+		SDL_AtomicSet(&jl_print__.sleeping, 1);
+		jl_print_drain__(jl);
+		SDL_SemWaitTimeout(jl_print__.wake, JL_PRINT_FLUSH_MS);
+		SDL_AtomicSet(&jl_print__.sleeping, 0);
+	}
+	return 0;
+}
+
+// Queue a line on "owner"'s ring, or write it now if there's no writer thread
+// or the caller isn't a JL_Lib thread ( it doesn't own a ring ).
+static void jl_print_line__(jl_t *jl, jl_ctx_t* owner, jl_print_line_t* line) {
+	jl_comm_t* ring;
+
+	if(owner == NULL || !SDL_AtomicGet(&jl_print__.running)) {
+		jl_print_lock__(jl);
+		jl_print_out__(jl, line);
+		jl_print_unlock__(jl);
+		return;
+	}
+	if((ring = owner->print_ring) == NULL) {
+		ring = jl_thread_comm_make(jl, sizeof(jl_print_line_t),
+			JL_PRINT_RING);
+		// Make the ring before the writer thread can see it.
+		SDL_MemoryBarrierRelease();
+		SDL_AtomicSetPtr((void**)&owner->print_ring, ring);
+	}
+	// Never wait for the writer: drop the line if the ring is full.
+	if(!jl_thread_comm_send(jl, ring, line)) {
+		SDL_AtomicAdd(&jl_print__.dropped, 1);
+		return;
+	}
+	if(SDL_AtomicCAS(&jl_print__.sleeping, 1, 0))
+		SDL_SemPost(jl_print__.wake);
+}
+
+static void _jl_print_current(jl_print_line_t* line, jl_ctx_t* ctx) {
+	int i;
+
+	jl_print_add__(line, " <");
+	for(i = 0; i < ctx->print.level; i++)
+		jl_print_add__(line, "%s/", ctx->print.stack[i+1]);
+	if(line->text[line->len - 1] == '/') line->len--;
+	jl_print_add__(line, ">\n");
+}
+
+static void jl_print_indent__(jl_print_line_t* line, i8_t o, jl_ctx_t* ctx) {
 	int i;
 	// Print enough spaces for the open blocks.
-	for(i = 0; i < jl->jl_ctx[thread_id].print.level + o; i++)
-		JL_PRINT(" ");
+	for(i = 0; i < ctx->print.level + o; i++)
+		jl_print_add__(line, " ");
 }
 
-static inline void _jl_print_new_block(jl_t *jl, u8_t thread_id) {
+static inline void _jl_print_new_block(jl_print_line_t* line, jl_ctx_t* ctx) {
 	int i;
-	i8_t ofs2 = jl->jl_ctx[thread_id].print.ofs2;
-	u8_t level = jl->jl_ctx[thread_id].print.level;
-
-	jl->jl_ctx[thread_id].print.ofs2 = 0;
-	JL_PRINT("[");
-	for(i = level - ofs2; i < level; i++) {
-		JL_PRINT("/");
-		JL_PRINT("%s", jl->jl_ctx[thread_id].print.stack[i+1]);
-	}
-	JL_PRINT("]");
-	_jl_print_current(jl, thread_id);
+	i8_t ofs2 = ctx->print.ofs2;
+	u8_t level = ctx->print.level;
+
+	ctx->print.ofs2 = 0;
+	jl_print_add__(line, "[");
+	for(i = level - ofs2; i < level; i++)
+		jl_print_add__(line, "/%s", ctx->print.stack[i+1]);
+	jl_print_add__(line, "]");
+	_jl_print_current(line, ctx);
 }
 
-static inline void _jl_print_old_block(jl_t *jl, u8_t thread_id) {
+static inline void _jl_print_old_block(jl_print_line_t* line, jl_ctx_t* ctx) {
 	int i;
-	i8_t ofs2 = jl->jl_ctx[thread_id].print.ofs2;
-	u8_t level = jl->jl_ctx[thread_id].print.level;
-
-	jl->jl_ctx[thread_id].print.ofs2 = 0;
-	JL_PRINT("[\\");
-	for(i = level; i > level + ofs2; i--) {
-		JL_PRINT("%s", jl->jl_ctx[thread_id].print.stack[i+1]);
-		JL_PRINT("\\");
-	}
-	JL_PRINT("\b]");
-	_jl_print_current(jl, thread_id);
+	i8_t ofs2 = ctx->print.ofs2;
+	u8_t level = ctx->print.level;
+
+	ctx->print.ofs2 = 0;
+	jl_print_add__(line, "[\\");
+	for(i = level; i > level + ofs2; i--)
+		jl_print_add__(line, "%s\\", ctx->print.stack[i+1]);
+	if(line->text[line->len - 1] == '\\') line->len--;
+	jl_print_add__(line, "]");
+	_jl_print_current(line, ctx);
 }
 
-static inline void jl_print_descriptor_(jl_t* jl, u8_t thread_id) {
-	if(jl->jl_ctx[thread_id].print.ofs2 > 0) {
-		jl_print_indent__(jl, -1, thread_id);
-		_jl_print_new_block(jl, thread_id);
-	}else if(jl->jl_ctx[thread_id].print.ofs2 < 0) {
-		jl_print_indent__(jl, 0, thread_id);
-		_jl_print_old_block(jl, thread_id);
+// Print the blocks opened or closed since the last line.
+static inline void jl_print_descriptor_(jl_t* jl, jl_ctx_t* ctx,
+	jl_ctx_t* owner)
+{
+	jl_print_line_t line;
+
+	line.len = 0;
+	if(ctx->print.ofs2 > 0) {
+		jl_print_indent__(&line, -1, ctx);
+		_jl_print_new_block(&line, ctx);
+	}else if(ctx->print.ofs2 < 0) {
+		jl_print_indent__(&line, 0, ctx);
+		_jl_print_old_block(&line, ctx);
 	}
-	jl_print_indent__(jl, 0, thread_id);
-	JL_PRINT("[%s] ", jl->jl_ctx[thread_id].print.stack
-		[jl->jl_ctx[thread_id].print.level]);
+	if(line.len) jl_print_line__(jl, owner, &line);
 }
 
-static void jl_print_test_overreach(jl_t* jl, u8_t thread_id) {
-	u8_t level = jl->jl_ctx[thread_id].print.level;
-	
+static void jl_print_test_overreach(jl_t* jl, jl_ctx_t* ctx) {
+	u8_t level = ctx->print.level;
+
 	if(level > 49) {
+		jl_print_flush(jl);
 		JL_PRINT("Overreached block count %d!!!\n", level);
 		JL_PRINT("Quitting....\n");
 		exit(0);
 	}
 }
 
-static void jl_print_reset_print_descriptor_(jl_t* jl, u8_t thread_id) {
-	// Check to see if too many blocks are open.
-	jl_print_test_overreach(jl, thread_id);
-	// Print the print descriptor.
-	jl_print_descriptor_(jl, thread_id);
-}
+// Split text into lines, each after the name of the block it's printed in.
+static void jl_print_tolines__(jl_t* jl, jl_ctx_t* ctx, jl_ctx_t* owner,
+	str_t input)
+{
+	jl_print_line_t line;
+	str_t text = input;
 
-static void jl_print_toconsole__(jl_t* jl, str_t input) {
-	jvct_t *_jl = jl->_jl;
-	uint8_t thread_id = jl_thread_current(jl);
-	int i = 0;
-
-	jl_mem_copyto(input, _jl->me.buffer, strlen(input) + 1);
-	while(i != -1) {
-		str_t text = _jl->me.buffer + (80 * i);
-		// If string is empty; quit
-		if((!text) || (!text[0])) break;
-		// Clear and reset the print buffer
-		jl_print_reset_print_descriptor_(jl, thread_id);
+	// Print the input in lines, straight from the input ( no copy ).
+	while(text && text[0]) {
 		// Print upto 80 characters to the terminal
-		int chr_cnt = 73 - jl->jl_ctx[thread_id].print.level;
-		char convert[10];
-		if(strlen(text) > chr_cnt - 1) {
-			i++;
-		}else{
-			chr_cnt = strlen(text);
-			i = -1; // break
-		}
+		int chr_cnt = 73 - ctx->print.level;
+		int len = strlen(text);
+
+		jl_print_descriptor_(jl, ctx, owner);
+		if(len > chr_cnt) len = chr_cnt;
+		line.len = 0;
+		jl_print_indent__(&line, 0, ctx);
+		jl_print_add__(&line, "[%s] %.*s\n",
+			ctx->print.stack[ctx->print.level], len, text);
+		jl_print_line__(jl, owner, &line);
+		text += len;
+	}
+}
 
-		sprintf(convert, "%%%ds\n", chr_cnt);
+static void jl_print_toconsole__(jl_t* jl, str_t text) {
+	JL_PRINT("%s", text);
+}
 
-		JL_PRINT(convert, text);
-		jl_file_print(jl, _jl->fl.paths.errf,
-			jl_mem_format(jl, convert, text));
-	}
+// Write out what's queued when the program calls exit() without quitting.
+static void jl_print_atexit__(void) {
+	if(SDL_AtomicGet(&jl_print__.running))
+		jl_print_drain__(jl_print__.jl);
 }
 
 //
@@ -123,37 +289,85 @@ static void jl_print_toconsole__(jl_t* jl, str_t input) {
 //
 
 /**
- * Set the function used to print out information.
+ * Set the function used to print out lines to the console.  It's called on
+ * the writer thread, with 1 whole line ( ending in a newline ) at a time.  It
+ * must not print ( or the lines it prints would be printed again ).
  * @param jl: The library context.
  * @param fn_: The function to run when printing.  For default use NULL.
 */
 void jl_print_set(jl_t* jl, jl_print_fnt fn_) {
+	jl_print_lock__(jl);
 	if(fn_) //User-Defined function
 		jl->print.printfn = fn_;
 	else //NULL
 		jl->print.printfn = jl_print_toconsole__;
+	jl_print_unlock__(jl);
 }
 
-static void jl_print_function__(jl_t* jl, str_t fn_name, u8_t thread_id) {
-//	uint8_t thread_id = jl_thread_current(jl);
-	int size = strlen(fn_name);
-
-	jl->jl_ctx[thread_id].print.level++;
-	jl->jl_ctx[thread_id].print.ofs2++;
-	jl_mem_copyto(fn_name, jl->jl_ctx[thread_id].print.stack
-		[jl->jl_ctx[thread_id].print.level], size);
-	jl->jl_ctx[thread_id].print.stack
-		[jl->jl_ctx[thread_id].print.level][size] = '\0';
-
-/*	jl->jl_ctx[thread_id].print.level++;*/
-/*	jl->jl_ctx[thread_id].print.ofs2++;*/
-/*	jl_mem_copyto(jl->jl_ctx[jl_thread_current(jl)].temp,*/
-/*		jl->jl_ctx[thread_id].print.stack*/
-/*			[jl->jl_ctx[thread_id].print.level], 255);*/
-/*	i32_t size = strlen(jl->jl_ctx[thread_id].print.stack*/
-/*			[jl->jl_ctx[thread_id].print.level]);*/
-/*	jl->jl_ctx[thread_id].print.stack*/
-/*		[jl->jl_ctx[thread_id].print.level][size] = '\0';*/
+/**
+ * Add a function that gets every line printed, along with the console and the
+ * log file.  It's called on the writer thread, with 1 line at a time.  It must
+ * not print ( or the lines it prints would be printed again ).
+ * @param jl: The library context.
+ * @param fn: The function.
+ * @returns: 1 if it was added, 0 if there are already JL_PRINT_SINKS.
+**/
+u8_t jl_print_sink_add(jl_t* jl, jl_print_fnt fn) {
+	m_u8_t rtn = 0;
+
+	jl_print_lock__(jl);
+	if(jl_print__.sink_count < JL_PRINT_SINKS) {
+		jl_print__.sinks[jl_print__.sink_count] = fn;
+		jl_print__.sink_count++;
+		rtn = 1;
+	}
+	jl_print_unlock__(jl);
+	return rtn;
+}
+
+/**
+ * Stop sending lines to a function added with jl_print_sink_add().
+ * @param jl: The library context.
+ * @param fn: The function.
+**/
+void jl_print_sink_remove(jl_t* jl, jl_print_fnt fn) {
+	m_u8_t i;
+
+	jl_print_lock__(jl);
+	for(i = 0; i < jl_print__.sink_count; i++) {
+		if(jl_print__.sinks[i] != fn) continue;
+		jl_print__.sink_count--;
+		jl_print__.sinks[i] = jl_print__.sinks[jl_print__.sink_count];
+		break;
+	}
+	jl_print_unlock__(jl);
+}
+
+/**
+ * Write out all queued lines now, instead of waiting for the writer thread.
+ * @param jl: The library context.
+**/
+void jl_print_flush(jl_t* jl) {
+	if(SDL_AtomicGet(&jl_print__.running)) jl_print_drain__(jl);
+}
+
+/**
+ * Get how many lines were dropped, because a thread printed faster than they
+ * could be written.
+ * @param jl: The library context.
+ * @returns: The number of lines dropped.
+**/
+u32_t jl_print_dropped(jl_t* jl) {
+	return SDL_AtomicGet(&jl_print__.dropped);
+}
+
+// Push a block's name ( just the pointer, the name isn't copied ).
+static void jl_print_function__(jl_t* jl, str_t fn_name, jl_ctx_t* ctx) {
+	ctx->print.level++;
+	ctx->print.ofs2++;
+	// Check to see if too many blocks are open.
+	jl_print_test_overreach(jl, ctx);
+	ctx->print.stack[ctx->print.level] = fn_name;
 }
 
 /**
@@ -162,35 +376,46 @@ static void jl_print_function__(jl_t* jl, str_t fn_name, u8_t thread_id) {
  * @param format: what to print.
 */
 void jl_print(jl_t* jl, str_t format, ... ) {
-	jl_thread_mutex_lock(jl, jl->print.mutex);
-
-	u8_t thread_id = jl_thread_current(jl);
-	jl_print_fnt print_out_ = jl->print.printfn;
+	jl_ctx_t* owner = jl_thread_get__(jl);
+	jl_ctx_t* ctx = owner;
+	jl_ctx_t other;
+	char* data = NULL;
+	m_u32_t size = 0;
 	va_list arglist;
-
-	// Store the format in jl->temp.
+	str_t text;
+
+	// Threads not made by JL_Lib don't have a context, so they use their
+	// own block & buffer ( not the main thread's ).
+	if(owner == NULL) {
+		ctx = &other;
+		ctx->print.stack[0] = "Other";
+		ctx->print.level = 0;
+		ctx->print.ofs2 = 0;
+	}
+	// Format into this thread's log buffer ( grows to fit ).
 	va_start( arglist, format );
-	vsprintf( jl->jl_ctx[jl_thread_current(jl)].temp, format, arglist );
+	text = owner ? jl_mem_vformat__(jl, &ctx->log.data, &ctx->log.size,
+		format, arglist) : jl_mem_vformat__(jl, &data, &size, format,
+		arglist);
 	va_end( arglist );
-	// Check to see if too many blocks are open.
-	jl_print_test_overreach(jl, thread_id);
 	// Print out.
-	print_out_(jl, jl->jl_ctx[jl_thread_current(jl)].temp);
-
-	jl_thread_mutex_unlock(jl, jl->print.mutex);
+	jl_print_tolines__(jl, ctx, owner, text);
+	if(data) jl_mem(jl, data, 0);
 }
 
+#ifndef JL_PRINT_NO_STACK
+
 /**
- * Open a printing block.
+ * Open a printing block.  Only a pointer to the name is kept, so it must stay
+ * around until the block is closed ( use a string literal ).  Does nothing on
+ * threads that weren't made by JL_Lib.
  * @param jl: The library context.
  * @param fn_name: The name of the block.
 **/
 void jl_print_function(jl_t* jl, str_t fn_name) {
-	uint8_t thread_id = jl_thread_current(jl);
+	jl_ctx_t* ctx = jl_thread_get__(jl);
 
-	jl_thread_mutex_lock(jl, jl->print.mutex);
-	jl_print_function__(jl, fn_name, thread_id);
-	jl_thread_mutex_unlock(jl, jl->print.mutex);
+	if(ctx) jl_print_function__(jl, fn_name, ctx);
 }
 
 /**
@@ -199,54 +424,60 @@ void jl_print_function(jl_t* jl, str_t fn_name) {
  * @param fn_name: The name of the block.
 **/
 void jl_print_return(jl_t* jl, str_t fn_name) {
-	uint8_t thread_id = jl_thread_current(jl);
+	jl_ctx_t* ctx = jl_thread_get__(jl);
+	str_t name;
 
-	jl_thread_mutex_lock(jl, jl->print.mutex);
-	if(strcmp(fn_name, jl->jl_ctx[thread_id].print.stack
-		[jl->jl_ctx[thread_id].print.level]))
-	{
+	if(ctx == NULL) return;
+	name = ctx->print.stack[ctx->print.level];
+	// Usually the same literal, so the names only need comparing if not.
+	if(fn_name != name && strcmp(fn_name, name)) {
 		jl_print(jl, "Error returning \"%s\" on thread #%d:\n",
-			fn_name, thread_id);
-		jl_print(jl, "\tFunction \"%s\" didn't return.",
-			jl->jl_ctx[thread_id].print.stack[
-				jl->jl_ctx[thread_id].print.level]);
+			fn_name, jl_thread_current(jl));
+		jl_print(jl, "\tFunction \"%s\" didn't return.", name);
 		jl_sg_kill(jl);
 	}
-	jl_mem_clr(jl->jl_ctx[thread_id].print.stack
-		[jl->jl_ctx[thread_id].print.level], 30);
-	jl->jl_ctx[thread_id].print.level--;
-	jl->jl_ctx[thread_id].print.ofs2 -= 1;
-	jl_thread_mutex_unlock(jl, jl->print.mutex);
+	ctx->print.stack[ctx->print.level] = NULL;
+	ctx->print.level--;
+	ctx->print.ofs2 -= 1;
 }
 
+#endif
+
 /**
- * Print out a stacktrace.
+ * Print out a stacktrace.  It's written out before returning, since it's
+ * usually followed by exit().  If JL_PRINT_NO_STACK is defined in "jl_me.h"
+ * it only has "JL_Lib".
  * @param jl: The libary context.
 **/
 void jl_print_stacktrace(jl_t* jl) {
-	uint8_t thread_id = jl_thread_current(jl);
+	jl_ctx_t* ctx = jl_thread_get__(jl);
 	int i;
 
+	// Threads not made by JL_Lib don't have a stack ( don't print main's ).
+	if(ctx == NULL) {
+		jl_print(jl, "Stacktrace for thread not made by JL_Lib:");
+		jl_print(jl, "Other");
+		jl_print_flush(jl);
+		return;
+	}
 	jl_print(jl, "Stacktrace for thread #%d (Most Recent Call Last):",
-		thread_id);
-	jl_thread_mutex_lock(jl, jl->print.mutex);
-	for(i = 0; i <= jl->jl_ctx[thread_id].print.level; i++) {
-		jl_thread_mutex_unlock(jl, jl->print.mutex);
-		jl_print(jl, jl->jl_ctx[thread_id].print.stack[i]);
-		jl_thread_mutex_lock(jl, jl->print.mutex);
+		jl_thread_current(jl));
+	for(i = 0; i <= ctx->print.level; i++) {
+		jl_print(jl, "%s", ctx->print.stack[i]);
 	}
-	jl_thread_mutex_unlock(jl, jl->print.mutex);
+	jl_print_flush(jl);
 }
 
-void jl_print_init_thread__(jl_t* jl, u8_t thread_id) {
+void jl_print_init_thread__(jl_t* jl, jl_ctx_t* ctx) {
 	uint8_t i;
 
 	for(i = 0; i < 50; i++) {
-		jl_mem_clr(jl->jl_ctx[thread_id].print.stack[i], 30);
+		ctx->print.stack[i] = NULL;
 	}
-	jl->jl_ctx[thread_id].print.level = 0;
-	jl->jl_ctx[thread_id].print.ofs2 = 0;
-	jl_print_function__(jl, "JL_Lib", thread_id);
+	ctx->print.stack[0] = "";
+	ctx->print.level = 0;
+	ctx->print.ofs2 = 0;
+	jl_print_function__(jl, "JL_Lib", ctx);
 }
 
 void jl_print_init__(jl_t* jl) {
@@ -254,14 +485,51 @@ void jl_print_init__(jl_t* jl) {
 	// Enable standard application logging
 	SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
 	#endif
-	jl->print.mutex = jl_thread_mutex_new(jl);
+	jl_print__.mutex = jl_thread_mutex_new(jl);
+	jl_thread_mutex_name(jl, jl_print__.mutex, "print");
 	jl_print_set(jl, NULL);
-	jl_print_init_thread__(jl, 0);
+	jl_print_init_thread__(jl, jl_thread_get_safe__(jl));
+	// Start the writer thread.
+	jl_print__.jl = jl;
+	jl_print__.file_done = 0;
+	SDL_AtomicSet(&jl_print__.quit, 0);
+	SDL_AtomicSet(&jl_print__.sleeping, 0);
+	if((jl_print__.wake = SDL_CreateSemaphore(0)) == NULL) {
+		jl_print(jl, "jl_print_init__: Couldn't create semaphore");
+		exit(-1);
+	}
+	jl_print__.thread = jl_thread_new(jl, "JL_Lib/Print",
+		jl_print_writer__);
+	SDL_AtomicSet(&jl_print__.running, 1);
+	atexit(jl_print_atexit__);
 }
 
 void jl_print_kill__(jl_t * jl) {
+	m_u16_t i;
+
 	jl_print(jl, "Killing printing....");
 	jl_print_return(jl, "JL_Lib");
 	jl_print(jl, "Killed Printing!");
-	jl_thread_mutex_old(jl, jl->print.mutex);
+	// Stop the writer thread, then write what's left on this thread.
+	SDL_AtomicSet(&jl_print__.quit, 1);
+	SDL_SemPost(jl_print__.wake);
+	jl_thread_old(jl, jl_print__.thread);
+	SDL_DestroySemaphore(jl_print__.wake);
+	jl_print_drain__(jl);
+	SDL_AtomicSet(&jl_print__.running, 0);
+	// Anything printed from now on is written right away.
+	jl_print_lock__(jl);
+	for(i = 0; i < jl->thread_count; i++) {
+		if(jl->jl_ctx[i]->print_ring == NULL) continue;
+		jl_thread_comm_kill(jl, jl->jl_ctx[i]->print_ring);
+		jl->jl_ctx[i]->print_ring = NULL;
+	}
+	if(jl_print__.file) fclose(jl_print__.file);
+	jl_print__.file = NULL;
+	jl_print__.file_done = 1;
+	if(jl_print__.file_old) jl_mem(jl, jl_print__.file_old, 0);
+	jl_print__.file_old = NULL;
+	jl_print_unlock__(jl);
+	jl_thread_mutex_old(jl, jl_print__.mutex);
+	jl_print__.mutex = NULL;
 }
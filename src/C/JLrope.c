@@ -0,0 +1,184 @@
+/*
+ * JL_Lib
+ * Copyright (c) 2015 Jeron A. Lau
+*/
+/** \file
+ * JLrope.c
+ *	Ropes: data that's too big for one allocation, kept in fixed-size
+ *	chunks.  Appending never moves the existing chunks, and because every
+ *	chunk is the same size, finding the chunk for a position is a shift.
+**/
+#include "jl_pr.h"
+
+//
+// Internal Functions
+//
+
+/**
+ * Get where the next byte appended to "rope" goes, allocating a new chunk if
+ * the last one is full.  After writing, add the # of bytes to rope->size.
+ * @param jl: The library context.
+ * @param rope: The rope to append to.
+ * @param room: Set to how many bytes can be written before the chunk ends.
+ * @returns: Where to write.
+**/
+uint8_t* jl_rope_tail__(jl_t* jl, jl_rope_t* rope, m_u32_t* room) {
+	u32_t at = rope->size & (JL_ROPE_CHUNK - 1);
+	u32_t chunk = rope->size >> JL_ROPE_SHIFT;
+
+	if(chunk == rope->count) {
+		// Only the small array of chunk pointers is ever reallocated.
+		if(rope->count == rope->slots) {
+			rope->slots = rope->slots ? rope->slots * 2 : 8;
+			rope->chunks = jl_mem__(jl, rope->chunks,
+				rope->slots * sizeof(uint8_t*), JL_MEM_TAG_DATA);
+		}
+		// Plain aligned memory: a 1 MiB chunk is too small for huge
+		// pages, so mapping each one would only add a system call.
+		rope->chunks[rope->count] = jl_mem_aligned__(jl, JL_ROPE_CHUNK,
+			JL_MEM_ALIGN, JL_MEM_TAG_DATA);
+		rope->count++;
+	}
+	*room = JL_ROPE_CHUNK - at;
+	return rope->chunks[chunk] + at;
+}
+
+//
+// Exported Functions
+//
+
+/**
+ * Make an empty rope.
+ * @param jl: The library context.
+ * @returns: The new rope, free it with jl_rope_free().
+**/
+jl_rope_t* jl_rope_make(jl_t* jl) {
+	jl_rope_t* rope = jl_memi__(jl, sizeof(jl_rope_t), JL_MEM_TAG_DATA);
+
+	rope->chunks = NULL;
+	rope->count = rope->slots = 0;
+	rope->size = rope->curs = 0;
+	return rope;
+}
+
+/**
+ * Free a rope and all of it's chunks.
+ * @param jl: The library context.
+ * @param rope: The rope to free.
+**/
+void jl_rope_free(jl_t* jl, jl_rope_t* rope) {
+	m_u32_t i;
+
+	for(i = 0; i < rope->count; i++)
+		jl_mem__(jl, rope->chunks[i], 0, JL_MEM_TAG_DATA);
+	if(rope->chunks) jl_mem__(jl, rope->chunks, 0, JL_MEM_TAG_DATA);
+	jl_mem__(jl, rope, 0, JL_MEM_TAG_DATA);
+}
+
+/**
+ * Add bytes to the end of a rope.  Existing chunks aren't copied.
+ * @param jl: The library context.
+ * @param rope: The rope to append to.
+ * @param data: The bytes to append.
+ * @param size: How many bytes to append.
+**/
+void jl_rope_append(jl_t* jl, jl_rope_t* rope, const void* data, u64_t size) {
+	const uint8_t* src = data;
+	m_u64_t left = size;
+
+	while(left) {
+		m_u32_t room;
+		uint8_t* dst = jl_rope_tail__(jl, rope, &room);
+
+		if(room > left) room = left;
+		jl_mem_copyto(src, dst, room);
+		rope->size += room;
+		src += room;
+		left -= room;
+	}
+}
+
+/**
+ * Move the cursor of a rope ( clamped to the end ).
+ * @param rope: The rope.
+ * @param curs: The new cursor.
+**/
+void jl_rope_seek(jl_rope_t* rope, u64_t curs) {
+	rope->curs = curs > rope->size ? rope->size : curs;
+}
+
+/**
+ * Get bytes at the cursor without copying, and move the cursor past them.
+ * The view stops at the end of the chunk, so call again for more.
+ * @param rope: The rope to read.
+ * @returns: The bytes, or an empty view at the end of the rope.
+**/
+jl_view_t jl_rope_chunk(jl_rope_t* rope) {
+	u32_t at = rope->curs & (JL_ROPE_CHUNK - 1);
+	m_u64_t size = JL_ROPE_CHUNK - at;
+
+	if(rope->curs >= rope->size) return jl_view_make(NULL, 0);
+	if(size > rope->size - rope->curs) size = rope->size - rope->curs;
+	jl_view_t rtn =
+		jl_view_make(rope->chunks[rope->curs >> JL_ROPE_SHIFT] + at, size);
+	rope->curs += size;
+	return rtn;
+}
+
+/**
+ * Copy bytes at the cursor, and move the cursor past them.
+ * @param rope: The rope to read.
+ * @param dst: Where to copy to.
+ * @param size: The most bytes to copy.
+ * @returns: How many bytes were copied ( less than "size" at the end ).
+**/
+u64_t jl_rope_read(jl_rope_t* rope, void* dst, u64_t size) {
+	uint8_t* out = dst;
+	m_u64_t got = 0;
+
+	while(got < size) {
+		jl_view_t part;
+		u64_t curs = rope->curs;
+
+		if((part = jl_rope_chunk(rope)).size == 0) break;
+		if(part.size > size - got) {
+			part.size = size - got;
+			rope->curs = curs + part.size;
+		}
+		jl_mem_copyto(part.data, out + got, part.size);
+		got += part.size;
+	}
+	return got;
+}
+
+/**
+ * Get the byte at the cursor, and move the cursor to the next byte.
+ * @param rope: The rope to read.
+ * @returns: The byte, or 0 at the end of the rope.
+**/
+u8_t jl_rope_byte(jl_rope_t* rope) {
+	if(rope->curs >= rope->size) return 0;
+	u8_t byte = rope->chunks[rope->curs >> JL_ROPE_SHIFT]
+		[rope->curs & (JL_ROPE_CHUNK - 1)];
+	rope->curs++;
+	return byte;
+}
+
+/**
+ * Copy the next "size" bytes at the cursor into "window", so they can be read
+ * with the data_t & jl_stream_t functions.  "window"'s memory is reused, so
+ * streaming a large rope through it doesn't allocate.
+ * @param jl: The library context.
+ * @param rope: The rope to read.
+ * @param window: The data_t to fill ( it's cursor is reset to 0 ).
+ * @param size: The most bytes to copy.
+ * @returns: How many bytes were copied, 0 at the end of the rope.
+**/
+u32_t jl_rope_window(jl_t* jl, jl_rope_t* rope, data_t* window, u32_t size) {
+	u64_t left = rope->size - rope->curs;
+
+	jl_data_resize(jl, window, left < size ? left : size);
+	jl_rope_read(rope, window->data, window->size);
+	window->curs = 0;
+	return window->size;
+}
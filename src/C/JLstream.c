@@ -0,0 +1,390 @@
+/*
+ * JL_Lib
+ * Copyright (c) 2015 Jeron A. Lau
+*/
+/** \file
+ * JLstream.c
+ *	Binary streams: read & write little-endian numbers, varints and blobs at
+ *	the cursor of a data_t.  Reads never go past the end of the data, they
+ *	set the stream's error flag and return 0 instead.  Writes grow the data,
+ *	or set the error flag if it would pass 4 GiB.
+**/
+#include "jl_pr.h"
+
+//
+// Internal Functions
+//
+
+// Check that "size" bytes can be read, setting the error flag if not.
+static inline u8_t jl_stream_check__(jl_stream_t* stream, u32_t size) {
+	data_t* data = stream->data;
+
+	if(stream->error || data->curs > data->size ||
+		size > data->size - data->curs)
+	{
+		stream->error = 1;
+		return 0;
+	}
+	return 1;
+}
+
+// Make room to write "size" bytes at the cursor, returning where to write.
+// Returns NULL & sets the error flag if the data can't get that big.
+static inline uint8_t* jl_stream_room__(jl_stream_t* stream, u32_t size) {
+	data_t* data = stream->data;
+	uint8_t* rtn;
+
+	if(size > UINT32_MAX - data->curs) {
+		stream->error = 1;
+		return NULL;
+	}
+	// jl_data_resize() grows geometrically, so this is amortized O(1).
+	if(data->curs + size > data->size)
+		jl_data_resize(stream->jl, data, data->curs + size);
+	rtn = data->data + data->curs;
+	data->curs += size;
+	return rtn;
+}
+
+static void jl_stream_write_le__(jl_stream_t* stream, u64_t value, u8_t size) {
+	uint8_t* dst = jl_stream_room__(stream, size);
+	uint8_t i;
+
+	if(dst == NULL) return;
+	for(i = 0; i < size; i++) dst[i] = value >> (i * 8);
+}
+
+static u64_t jl_stream_read_le__(jl_stream_t* stream, u8_t size) {
+	m_u64_t value = 0;
+	uint8_t i;
+
+	if(!jl_stream_check__(stream, size)) return 0;
+	for(i = 0; i < size; i++) {
+		value |= ((u64_t)stream->data->data[stream->data->curs + i])
+			<< (i * 8);
+	}
+	stream->data->curs += size;
+	return value;
+}
+
+//
+// Exported Functions
+//
+
+/**
+ * Make a stream to read or write "data", starting at it's cursor.
+ * @param jl: The library context.
+ * @param data: The data to read or write ( not owned by the stream ).
+ * @returns: The stream, with it's error flag cleared.
+**/
+jl_stream_t jl_stream_make(jl_t* jl, data_t* data) {
+	return (jl_stream_t) { data, jl, 0 };
+}
+
+/**
+ * Write raw bytes at the cursor.
+ * @param stream: The stream.
+ * @param src: The bytes to write.
+ * @param size: How many bytes to write.
+**/
+void jl_stream_write(jl_stream_t* stream, const void* src, u32_t size) {
+	uint8_t* dst = jl_stream_room__(stream, size);
+
+	if(dst) jl_mem_copyto(src, dst, size);
+}
+
+/**
+ * Read raw bytes at the cursor.  If there aren't enough, "dst" is cleared and
+ * the error flag is set.
+ * @param stream: The stream.
+ * @param dst: Where to read the bytes to.
+ * @param size: How many bytes to read.
+ * @returns: 1 on success, 0 on error.
+**/
+u8_t jl_stream_read(jl_stream_t* stream, void* dst, u32_t size) {
+	if(!jl_stream_check__(stream, size)) {
+		jl_mem_clr(dst, size);
+		return 0;
+	}
+	jl_mem_copyto(stream->data->data + stream->data->curs, dst, size);
+	stream->data->curs += size;
+	return 1;
+}
+
+/**
+ * Write a byte.
+ * @param stream: The stream.
+ * @param value: What to write.
+**/
+void jl_stream_write_u8(jl_stream_t* stream, u8_t value) {
+	uint8_t* dst = jl_stream_room__(stream, 1);
+
+	if(dst) *dst = value;
+}
+
+/**
+ * Write a little-endian 16-bit integer.
+ * @param stream: The stream.
+ * @param value: What to write.
+**/
+void jl_stream_write_u16(jl_stream_t* stream, u16_t value) {
+	jl_stream_write_le__(stream, value, 2);
+}
+
+/**
+ * Write a little-endian 32-bit integer.
+ * @param stream: The stream.
+ * @param value: What to write.
+**/
+void jl_stream_write_u32(jl_stream_t* stream, u32_t value) {
+	jl_stream_write_le__(stream, value, 4);
+}
+
+/**
+ * Write a little-endian 64-bit integer.
+ * @param stream: The stream.
+ * @param value: What to write.
+**/
+void jl_stream_write_u64(jl_stream_t* stream, u64_t value) {
+	jl_stream_write_le__(stream, value, 8);
+}
+
+/**
+ * Write a little-endian 32-bit float.
+ * @param stream: The stream.
+ * @param value: What to write.
+**/
+void jl_stream_write_f32(jl_stream_t* stream, f32_t value) {
+	m_u32_t bits;
+
+	jl_mem_copyto(&value, &bits, 4);
+	jl_stream_write_le__(stream, bits, 4);
+}
+
+/**
+ * Write a little-endian 64-bit float.
+ * @param stream: The stream.
+ * @param value: What to write.
+**/
+void jl_stream_write_f64(jl_stream_t* stream, f64_t value) {
+	m_u64_t bits;
+
+	jl_mem_copyto(&value, &bits, 8);
+	jl_stream_write_le__(stream, bits, 8);
+}
+
+/**
+ * Read a byte.
+ * @param stream: The stream.
+ * @returns: The byte, 0 on error.
+**/
+u8_t jl_stream_read_u8(jl_stream_t* stream) {
+	return jl_stream_read_le__(stream, 1);
+}
+
+/**
+ * Read a little-endian 16-bit integer.
+ * @param stream: The stream.
+ * @returns: The integer, 0 on error.
+**/
+u16_t jl_stream_read_u16(jl_stream_t* stream) {
+	return jl_stream_read_le__(stream, 2);
+}
+
+/**
+ * Read a little-endian 32-bit integer.
+ * @param stream: The stream.
+ * @returns: The integer, 0 on error.
+**/
+u32_t jl_stream_read_u32(jl_stream_t* stream) {
+	return jl_stream_read_le__(stream, 4);
+}
+
+/**
+ * Read a little-endian 64-bit integer.
+ * @param stream: The stream.
+ * @returns: The integer, 0 on error.
+**/
+u64_t jl_stream_read_u64(jl_stream_t* stream) {
+	return jl_stream_read_le__(stream, 8);
+}
+
+/**
+ * Read a little-endian 32-bit float.
+ * @param stream: The stream.
+ * @returns: The float, 0 on error.
+**/
+f32_t jl_stream_read_f32(jl_stream_t* stream) {
+	u32_t bits = jl_stream_read_le__(stream, 4);
+	m_f32_t value;
+
+	jl_mem_copyto(&bits, &value, 4);
+	return value;
+}
+
+/**
+ * Read a little-endian 64-bit float.
+ * @param stream: The stream.
+ * @returns: The float, 0 on error.
+**/
+f64_t jl_stream_read_f64(jl_stream_t* stream) {
+	u64_t bits = jl_stream_read_le__(stream, 8);
+	m_f64_t value;
+
+	jl_mem_copyto(&bits, &value, 8);
+	return value;
+}
+
+/**
+ * Write an unsigned LEB128 varint ( 1 byte for values under 128 ).
+ * @param stream: The stream.
+ * @param value: What to write.
+**/
+void jl_stream_write_uvar(jl_stream_t* stream, u64_t value) {
+	uint8_t bytes[10];
+	m_u64_t left = value;
+	uint8_t size = 0;
+
+	do {
+		bytes[size] = left & 0x7F;
+		left >>= 7;
+		if(left) bytes[size] |= 0x80;
+		size++;
+	}while(left);
+	jl_stream_write(stream, bytes, size);
+}
+
+/**
+ * Read an unsigned LEB128 varint.  Sets the error flag if it's cut off or
+ * longer than 64 bits.
+ * @param stream: The stream.
+ * @returns: The value, 0 on error.
+**/
+u64_t jl_stream_read_uvar(jl_stream_t* stream) {
+	m_u64_t value = 0;
+	uint8_t shift = 0;
+
+	while(jl_stream_check__(stream, 1)) {
+		u8_t byte = stream->data->data[stream->data->curs++];
+
+		value |= ((u64_t)(byte & 0x7F)) << shift;
+		if(!(byte & 0x80)) return value;
+		shift += 7;
+		if(shift >= 64) break;
+	}
+	stream->error = 1;
+	return 0;
+}
+
+/**
+ * Write a signed varint ( zigzag encoded, so small negatives are short too ).
+ * @param stream: The stream.
+ * @param value: What to write.
+**/
+void jl_stream_write_ivar(jl_stream_t* stream, i64_t value) {
+	jl_stream_write_uvar(stream, ((u64_t)value << 1) ^ (u64_t)(value >> 63));
+}
+
+/**
+ * Read a signed varint.
+ * @param stream: The stream.
+ * @returns: The value, 0 on error.
+**/
+i64_t jl_stream_read_ivar(jl_stream_t* stream) {
+	u64_t value = jl_stream_read_uvar(stream);
+
+	return (i64_t)(value >> 1) ^ -(i64_t)(value & 1);
+}
+
+/**
+ * Write a blob: it's size as a varint, then it's bytes.
+ * @param stream: The stream.
+ * @param src: The bytes to write.
+ * @param size: How many bytes to write.
+**/
+void jl_stream_write_blob(jl_stream_t* stream, const void* src, u32_t size) {
+	jl_stream_write_uvar(stream, size);
+	jl_stream_write(stream, src, size);
+}
+
+/**
+ * Read a blob without copying it.
+ * @param stream: The stream.
+ * @returns: A view of the blob, valid until the data changes ( empty on
+ *	error ).
+**/
+jl_view_t jl_stream_read_blob(jl_stream_t* stream) {
+	u64_t size = jl_stream_read_uvar(stream);
+	jl_view_t rtn = { NULL, 0, 0 };
+
+	if(size > UINT32_MAX || !jl_stream_check__(stream, size)) {
+		stream->error = 1;
+		return rtn;
+	}
+	rtn.data = stream->data->data + stream->data->curs;
+	rtn.size = size;
+	stream->data->curs += size;
+	return rtn;
+}
+
+/**
+ * Write an array of little-endian numbers.  On little-endian CPUs this is a
+ * single copy.
+ * @param stream: The stream.
+ * @param src: The array.
+ * @param count: How many elements are in the array.
+ * @param size: Size of each element in bytes ( 1, 2, 4 or 8 ).
+**/
+void jl_stream_write_array(jl_stream_t* stream, const void* src, u32_t count,
+	u8_t size)
+{
+	uint8_t* dst;
+
+	// The array's size in bytes must fit in 32 bits.
+	if(size && count > UINT32_MAX / size) {
+		stream->error = 1;
+		return;
+	}
+	if((dst = jl_stream_room__(stream, count * size)) == NULL) return;
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+	jl_mem_copyto(src, dst, count * size);
+#else
+	const uint8_t* bytes = src;
+	m_u32_t i, j;
+
+	for(i = 0; i < count; i++) for(j = 0; j < size; j++)
+		dst[i * size + j] = bytes[i * size + (size - 1 - j)];
+#endif
+}
+
+/**
+ * Read an array of little-endian numbers.  If there aren't enough bytes,
+ * "dst" is cleared and the error flag is set.
+ * @param stream: The stream.
+ * @param dst: The array.
+ * @param count: How many elements to read.
+ * @param size: Size of each element in bytes ( 1, 2, 4 or 8 ).
+ * @returns: 1 on success, 0 on error.
+**/
+u8_t jl_stream_read_array(jl_stream_t* stream, void* dst, u32_t count,
+	u8_t size)
+{
+	// The array's size in bytes must fit in 32 bits.
+	if(size && count > UINT32_MAX / size) {
+		stream->error = 1;
+		return 0;
+	}
+	if(!jl_stream_read(stream, dst, count * size)) return 0;
+#if SDL_BYTEORDER != SDL_LIL_ENDIAN
+	uint8_t* bytes = dst;
+	m_u32_t i, j;
+
+	for(i = 0; i < count; i++) for(j = 0; j < size / 2; j++) {
+		uint8_t swap = bytes[i * size + j];
+
+		bytes[i * size + j] = bytes[i * size + (size - 1 - j)];
+		bytes[i * size + (size - 1 - j)] = swap;
+	}
+#endif
+	return 1;
+}
@@ -0,0 +1,190 @@
+/*
+ * JL_Lib
+ * Copyright (c) 2015 Jeron A. Lau 
+*/
+/** \file
+ * JLtext.c
+ *	Editable text.  A gap buffer: text is kept in 2 parts, at the start &
+ *	end of the buffer, with free space ( the gap ) between.  The gap follows
+ *	the cursor when the text is edited, so typing & deleting at the cursor
+ *	doesn't move the rest of the text.
+**/
+#include "jl_pr.h"
+
+//
+// Internal Functions
+//
+
+// Make room for at least "size" more bytes in the gap.
+static void jl_text_grow__(jl_t* jl, jl_text_t* text, u32_t size) {
+	u32_t tail = text->size - text->gape;
+	m_u32_t newsize = text->size ? text->size : JL_TEXT_MIN_GAP;
+
+	if(text->gape - text->gap >= size) return;
+	while(newsize - jl_text_length(text) < size) newsize *= 2;
+	// Keep 1 byte past the end, for the NUL from jl_text_string()
+	text->data = jl_mem__(jl, text->data, newsize + 1, JL_MEM_TAG_DATA);
+	// Move the text after the gap to the new end.
+	memmove(text->data + newsize - tail, text->data + text->gape, tail);
+	text->gape = newsize - tail;
+	text->size = newsize;
+}
+
+// Move the gap to the cursor.
+static void jl_text_gap__(jl_text_t* text) {
+	if(text->curs < text->gap) {
+		u32_t n = text->gap - text->curs;
+
+		memmove(text->data + text->gape - n, text->data + text->curs, n);
+		text->gap -= n;
+		text->gape -= n;
+	}else if(text->curs > text->gap) {
+		u32_t n = text->curs - text->gap;
+
+		memmove(text->data + text->gap, text->data + text->gape, n);
+		text->gap += n;
+		text->gape += n;
+	}
+}
+
+//
+// Exported Functions
+//
+
+/**
+ * Make editable text.
+ * @param jl: The library context.
+ * @param string: The starting text, or NULL for none.
+ * @returns: The new text, with the cursor at the end.
+**/
+jl_text_t* jl_text_make(jl_t* jl, str_t string) {
+	jl_text_t* text = jl_memi__(jl, sizeof(jl_text_t), JL_MEM_TAG_DATA);
+
+	if(string) jl_text_insert_data(jl, text, string, strlen(string));
+	return text;
+}
+
+/**
+ * Free editable text.
+ * @param jl: The library context.
+ * @param text: The text to free.
+**/
+void jl_text_free(jl_t* jl, jl_text_t* text) {
+	if(text->data) jl_mem__(jl, text->data, 0, JL_MEM_TAG_DATA);
+	jl_mem__(jl, text, 0, JL_MEM_TAG_DATA);
+}
+
+/**
+ * Get the length of the text.
+ * @param text: The text.
+ * @returns: The # of bytes of text.
+**/
+u32_t jl_text_length(const jl_text_t* text) {
+	return text->size - (text->gape - text->gap);
+}
+
+/**
+ * Get the cursor.
+ * @param text: The text.
+ * @returns: The cursor, from 0 to the length of the text.
+**/
+u32_t jl_text_cursor(const jl_text_t* text) {
+	return text->curs;
+}
+
+/**
+ * Move the cursor.
+ * @param text: The text.
+ * @param curs: Where to move the cursor ( truncated to the length ).
+**/
+void jl_text_seek(jl_text_t* text, u32_t curs) {
+	u32_t length = jl_text_length(text);
+
+	text->curs = curs > length ? length : curs;
+}
+
+/**
+ * Insert data at the cursor, and move the cursor past it.
+ * @param jl: The library context.
+ * @param text: The text.
+ * @param data: The bytes to insert.
+ * @param size: How many bytes to insert.
+**/
+void jl_text_insert_data(jl_t* jl, jl_text_t* text, const void* data,
+	u32_t size)
+{
+	jl_text_gap__(text);
+	jl_text_grow__(jl, text, size);
+	jl_mem_copyto(data, text->data + text->gap, size);
+	text->gap += size;
+	text->curs += size;
+}
+
+/**
+ * Insert a byte at the cursor, and move the cursor past it.
+ * @param jl: The library context.
+ * @param text: The text.
+ * @param byte: The byte to insert.
+**/
+void jl_text_insert(jl_t* jl, jl_text_t* text, u8_t byte) {
+	jl_text_insert_data(jl, text, &byte, 1);
+}
+
+/**
+ * Delete the byte after the cursor ( like the delete key ).
+ * @param text: The text.
+**/
+void jl_text_delete(jl_text_t* text) {
+	jl_text_gap__(text);
+	if(text->gape < text->size) text->gape++;
+}
+
+/**
+ * Delete the byte before the cursor ( like the backspace key ).
+ * @param text: The text.
+**/
+void jl_text_backspace(jl_text_t* text) {
+	jl_text_gap__(text);
+	if(text->gap) {
+		text->gap--;
+		text->curs--;
+	}
+}
+
+/**
+ * Get part of the text without copying it.  Part 0 followed by part 1 is the
+ * whole text.
+ * @param text: The text.
+ * @param part: Which part ( 0 or 1 ).
+ * @param size: Set to the # of bytes in the part.
+ * @returns: The part of the text ( not NUL terminated ).
+**/
+str_t jl_text_part(const jl_text_t* text, u8_t part, m_u32_t* size) {
+	if(part == 0) {
+		*size = text->gap;
+		return (void*)text->data;
+	}else{
+		*size = text->size - text->gape;
+		return (void*)(text->data + text->gape);
+	}
+}
+
+/**
+ * Get all of the text as a NUL terminated string.  This moves the gap to the
+ * end of the text, so only use it when a flat string is needed ( not for
+ * drawing every frame, see jlgr_draw_text_gap() ).
+ * @param jl: The library context.
+ * @param text: The text.
+ * @returns: The text, valid until it's next edited.
+**/
+str_t jl_text_string(jl_t* jl, jl_text_t* text) {
+	u32_t curs = text->curs;
+
+	// Make sure there's memory to put the NUL in.
+	if(text->data == NULL) jl_text_grow__(jl, text, 1);
+	text->curs = jl_text_length(text);
+	jl_text_gap__(text);
+	text->curs = curs;
+	text->data[text->gap] = '\0';
+	return (void*)text->data;
+}
@@ -6,15 +6,234 @@
  * JLthread.c
  *	This file handles a separate thread for drawing graphics.
 **/
+#define _GNU_SOURCE // For CPU_SET()
 #include "jl_pr.h"
 
+#if defined(__linux__)
+	#include <sched.h>
+	#include <sys/resource.h>
+	#include <sys/syscall.h>
+#endif
+
+// This thread's context & ID ( NULL & 0 until registered ).
+static __thread jl_ctx_t* jl_thread_ctx__ = NULL;
+static __thread m_u16_t jl_thread_id__ = 0;
+// The main thread's context, for threads that weren't made by jl_thread_new().
+static jl_ctx_t* jl_thread_main__ = NULL;
+
+#define JL_THREAD_PROFILE_MUTEXES 256 // Max # of mutexes the profiler tracks.
+
+#ifdef JL_THREAD_PROFILE
+typedef struct{
+	jl_mutex_stats_t stats;	// [ stats.mutex = NULL = Unused ]
+	m_u64_t locked;		// When the holder locked it.
+	m_u32_t depth;		// Times the holder locked it ( recursive ).
+	m_u8_t freed;		// Set if unused, but searches must go past it.
+}jl_thread_lock_t;
+
+// Everything below is protected by "jl_thread_profile_lock__".
+static SDL_SpinLock jl_thread_profile_lock__ = 0;
+static jl_thread_lock_t jl_thread_profile__[JL_THREAD_PROFILE_MUTEXES];
+#endif
+
+// What a new thread needs to register itself before running.
+typedef struct{
+	jl_t* jl;
+	SDL_ThreadFunction fn;
+	jl_ctx_t* ctx;
+	uint16_t id;
+	jl_thread_opt_t opt;
+}jl_thread_start_t;
+
 //
 // Static Functions
 //
 
+#ifdef JL_THREAD_PROFILE
+// Find "mutex"'s slot ( open addressing ), with the profile lock held.  If
+// it's not there & "add" is set, give it an unused slot.
+static jl_thread_lock_t* jl_thread_profile_find__(SDL_mutex* mutex, u8_t add) {
+	m_u32_t i = (((uintptr_t)mutex) >> 4) % JL_THREAD_PROFILE_MUTEXES;
+	jl_thread_lock_t* unused = NULL;
+	m_u32_t tries;
+
+	for(tries = 0; tries < JL_THREAD_PROFILE_MUTEXES; tries++) {
+		jl_thread_lock_t* lock = &jl_thread_profile__[i];
+
+		if(lock->stats.mutex == mutex) return lock;
+		if(lock->freed && unused == NULL) unused = lock;
+		// Past the end of the search: "mutex" isn't in the table.
+		if(lock->stats.mutex == NULL && !lock->freed) {
+			if(unused == NULL) unused = lock;
+			break;
+		}
+		i = (i + 1) % JL_THREAD_PROFILE_MUTEXES;
+	}
+	if(!add || unused == NULL) return NULL;
+	jl_mem_clr(unused, sizeof(jl_thread_lock_t));
+	unused->stats.mutex = mutex;
+	return unused;
+}
+
+static u64_t jl_thread_profile_us__(u64_t ticks) {
+	return (ticks * 1000000) / SDL_GetPerformanceFrequency();
+}
+
+// Record a lock of "mutex" that started waiting at "start".
+static void jl_thread_profile_locked__(SDL_mutex* mutex, u64_t start,
+	u8_t contended)
+{
+	u64_t now = SDL_GetPerformanceCounter();
+	u64_t wait = jl_thread_profile_us__(now - start);
+	jl_thread_lock_t* lock;
+
+	SDL_AtomicLock(&jl_thread_profile_lock__);
+	if((lock = jl_thread_profile_find__(mutex, 1))) {
+		lock->stats.count++;
+		lock->stats.contended += contended;
+		lock->stats.wait_total += wait;
+		if(wait > lock->stats.wait_max) lock->stats.wait_max = wait;
+		if(lock->depth++ == 0) lock->locked = now;
+	}
+	SDL_AtomicUnlock(&jl_thread_profile_lock__);
+}
+
+// Record how long "mutex" was held, before it's unlocked.
+static void jl_thread_profile_unlock__(SDL_mutex* mutex) {
+	u64_t now = SDL_GetPerformanceCounter();
+	jl_thread_lock_t* lock;
+
+	SDL_AtomicLock(&jl_thread_profile_lock__);
+	if((lock = jl_thread_profile_find__(mutex, 0)) && lock->depth &&
+		--lock->depth == 0)
+	{
+		u64_t hold = jl_thread_profile_us__(now - lock->locked);
+		m_u8_t bucket = 0;
+
+		while(bucket < 15 && (((u64_t)2) << bucket) <= hold) bucket++;
+		lock->stats.holds[bucket]++;
+	}
+	SDL_AtomicUnlock(&jl_thread_profile_lock__);
+}
+
+// Sort mutexes by time waited, most first.
+static int jl_thread_profile_cmp__(const void* a, const void* b) {
+	const jl_mutex_stats_t* sa = a;
+	const jl_mutex_stats_t* sb = b;
+
+	if(sa->wait_total == sb->wait_total) return 0;
+	return sa->wait_total < sb->wait_total ? 1 : -1;
+}
+#endif
+
+// Lock a mutex ( timing the wait when profiling ).
+static int jl_thread_mutex_lock__(SDL_mutex* mutex) {
+#ifdef JL_THREAD_PROFILE
+	u64_t start = SDL_GetPerformanceCounter();
+	m_u8_t contended = 0;
+	m_i32_t rtn = SDL_TryLockMutex(mutex);
+
+	if(rtn == SDL_MUTEX_TIMEDOUT) {
+		// Another thread has it.
+		contended = 1;
+		rtn = SDL_LockMutex(mutex);
+	}
+	if(rtn == 0) jl_thread_profile_locked__(mutex, start, contended);
+	return rtn;
+#else
+	return SDL_LockMutex(mutex);
+#endif
+}
+
+// Unlock a mutex ( timing the hold when profiling ).
+static void jl_thread_mutex_unlock__(SDL_mutex* mutex) {
+#ifdef JL_THREAD_PROFILE
+	jl_thread_profile_unlock__(mutex);
+#endif
+	SDL_UnlockMutex(mutex);
+}
+
 // Initialize a new thread.
-static void jl_thread_init_new(jl_t* jl, u8_t thread_id) {
-	jl_print_init_thread__(jl, thread_id);
+static void jl_thread_init_new(jl_t* jl, jl_ctx_t* ctx) {
+	jl_print_init_thread__(jl, ctx);
+}
+
+// Get an unused thread context, making a new one if all are in use.  Nothing
+// is allocated with "thread_lock" held ( allocating may shrink caches or quit,
+// which would need the lock ), so this allocates first & then checks again.
+static jl_ctx_t* jl_thread_ctx_new__(jl_t* jl, m_u16_t* id) {
+	jl_ctx_t* ctx = NULL;
+	jl_ctx_t* fresh = NULL;
+	jl_ctx_t** slots = NULL;
+	jl_ctx_t** old = NULL;
+	m_u16_t i, slot_count = 0, need;
+
+	while(1) {
+		SDL_AtomicLock(&jl->thread_lock);
+		// Reuse the context of a thread that exited ( skip main thread ).
+		for(i = 1; i < jl->thread_count; i++) {
+			if(!jl->jl_ctx[i]->used) {
+				ctx = jl->jl_ctx[i];
+				break;
+			}
+		}
+		if(ctx) break;
+		i = jl->thread_count;
+		if(i == UINT16_MAX) {
+			SDL_AtomicUnlock(&jl->thread_lock);
+			jl_print(jl, "More than %d threads!", UINT16_MAX);
+			exit(-1);
+		}
+		// Only the array of pointers moves, contexts stay put.
+		if(i == jl->thread_slots && slot_count > i) {
+			jl_mem_copyto(jl->jl_ctx, slots, i * sizeof(jl_ctx_t*));
+			old = jl->jl_ctx;
+			jl->jl_ctx = slots;
+			jl->thread_slots = slot_count;
+			slots = NULL;
+		}
+		if(fresh && i < jl->thread_slots) {
+			ctx = fresh;
+			fresh = NULL;
+			jl->jl_ctx[i] = ctx;
+			jl->thread_count++;
+			jl_mem_random_init__(ctx, i);
+			break;
+		}
+		need = jl->thread_slots >= UINT16_MAX / 2 ? UINT16_MAX :
+			jl->thread_slots ? jl->thread_slots * 2 : 16;
+		need = i == jl->thread_slots ? need : 0;
+		SDL_AtomicUnlock(&jl->thread_lock);
+		// Allocate what's missing without the lock, then check again.
+		if(fresh == NULL) fresh = jl_memi(jl, sizeof(jl_ctx_t));
+		if(need > slot_count) {
+			slots = jl_mem(jl, slots, need * sizeof(jl_ctx_t*));
+			slot_count = need;
+		}
+	}
+	ctx->used = 1;
+	SDL_AtomicUnlock(&jl->thread_lock);
+	// Free what wasn't needed after all.
+	if(old) jl_mem(jl, old, 0);
+	if(slots) jl_mem(jl, slots, 0);
+	if(fresh) jl_mem(jl, fresh, 0);
+	*id = i;
+	return ctx;
+}
+
+// Register the new thread, then run it's main function.
+static int jl_thread_start__(void* data) {
+	jl_thread_start_t start = *(jl_thread_start_t*)data;
+
+	jl_mem(start.jl, data, 0);
+	jl_thread_ctx__ = start.ctx;
+	jl_thread_id__ = start.id;
+	// Both only work from the thread itself.  New threads start with the
+	// creator's CPUs ( maybe just main's ), so undo that if no CPUs set.
+	jl_thread_pin(start.jl, start.opt.cpus ? start.opt.cpus :
+		jl_thread_cpus(start.jl, JL_THREAD_ANY));
+	if(start.opt.nice) jl_thread_nice(start.jl, start.opt.nice);
+	return start.fn(start.jl);
 }
 
 //
@@ -22,61 +241,62 @@ static void jl_thread_init_new(jl_t* jl, u8_t thread_id) {
 //
 
 /**
- * Create a thread.  User can program up to 16 threads.
+ * Create a thread.  There's no fixed limit on how many threads can be made,
+ * the contexts of threads that were waited for with jl_thread_old() are
+ * reused.
  * @param jl: The library context.
  * @param name: The name of the thread.
  * @param fn: The main function of the thread.
  * @returns: The thread ID number.
 **/
-uint8_t jl_thread_new(jl_t *jl, str_t name, SDL_ThreadFunction fn) {
-	int8_t i, rtn = -1;
-
-	// Skip main thread ( i = 1 )
-	for(i = 1; i < 16; i++) {
-		// Look for not init'd thread.
-		if(jl->jl_ctx[i].thread == NULL) {
-			// Run thread-specific initalizations
-			jl_thread_init_new(jl, i);
-			// Create a thread
-			jl->jl_ctx[i].thread =	SDL_CreateThread(fn, name, jl);
-			jl->jl_ctx[i].thread_id =
-				SDL_GetThreadID(jl->jl_ctx[i].thread);
-			// Check if success
-			if(jl->jl_ctx[i].thread == NULL) {
-				jl_print(jl, "SDL_CreateThread failed: %s",
-					SDL_GetError());
-				exit(-1);
-			}
-			rtn = i;
-			break;
-		}
-	}
-	if(rtn == -1) {
-		jl_print(jl, "More than 16 threads!");
+uint16_t jl_thread_new(jl_t *jl, str_t name, SDL_ThreadFunction fn) {
+	return jl_thread_new_opt(jl, name, fn, NULL);
+}
+
+/**
+ * Create a thread, with the CPUs it can run on & it's priority.
+ * @param jl: The library context.
+ * @param name: The name of the thread, also given to the OS ( Linux only
+ *	shows the first 15 characters ).
+ * @param fn: The main function of the thread.
+ * @param opt: The options, or NULL for the defaults.
+ * @returns: The thread ID number.
+**/
+uint16_t jl_thread_new_opt(jl_t *jl, str_t name, SDL_ThreadFunction fn,
+	const jl_thread_opt_t* opt)
+{
+	jl_thread_start_t* start = jl_memi(jl, sizeof(jl_thread_start_t));
+	jl_ctx_t* ctx;
+	m_u16_t id;
+
+	ctx = jl_thread_ctx_new__(jl, &id);
+	// Run thread-specific initalizations
+	jl_thread_init_new(jl, ctx);
+	// Create a thread
+	start->jl = jl;
+	start->fn = fn;
+	start->ctx = ctx;
+	start->id = id;
+	if(opt) start->opt = *opt;
+	ctx->thread = SDL_CreateThread(jl_thread_start__, name, start);
+	// Check if success
+	if(ctx->thread == NULL) {
+		jl_print(jl, "SDL_CreateThread failed: %s", SDL_GetError());
 		exit(-1);
 	}
-	JL_PRINT_DEBUG(jl, "Made thread #%d", rtn);
-	return rtn;
+	ctx->thread_id = SDL_GetThreadID(ctx->thread);
+	JL_PRINT_DEBUG(jl, "Made thread #%d", id);
+	return id;
 }
 
 /**
  * Return the ID of the current thread.
  * @param jl: The library context.
- * @returns: The thread ID number, 0 if main thread.
+ * @returns: The thread ID number, 0 if main thread ( or a thread that wasn't
+ *	made with jl_thread_new() ).
 **/
-uint8_t jl_thread_current(jl_t *jl) {
-	SDL_threadID current_thread = SDL_ThreadID();
-	uint8_t i, rtn = 0;
-
-	// Skip main thread ( i = 1 )
-	for(i = 1; i < 16; i++) {
-		// Look for not init'd thread.
-		if(jl->jl_ctx[i].thread_id == current_thread) {
-			rtn = i;
-			break;
-		}
-	}
-	return rtn;
+uint16_t jl_thread_current(jl_t *jl) {
+	return jl_thread_id__;
 }
 
 /**
@@ -85,13 +305,113 @@ uint8_t jl_thread_current(jl_t *jl) {
  * @param threadnum: The thread id returned from jl_thread_new().
  * @returns: Value returned from the thread.
 **/
-int32_t jl_thread_old(jl_t *jl, u8_t threadnum) {
+int32_t jl_thread_old(jl_t *jl, u16_t threadnum) {
 	int32_t threadReturnValue = 0;
+	jl_ctx_t* ctx;
 
-	SDL_WaitThread(jl->jl_ctx[threadnum].thread, &threadReturnValue);
+	SDL_AtomicLock(&jl->thread_lock);
+	ctx = jl->jl_ctx[threadnum];
+	SDL_AtomicUnlock(&jl->thread_lock);
+	SDL_WaitThread(ctx->thread, &threadReturnValue);
+	// Let jl_thread_new() reuse the context.
+	SDL_AtomicLock(&jl->thread_lock);
+	ctx->thread = NULL;
+	ctx->used = 0;
+	SDL_AtomicUnlock(&jl->thread_lock);
 	return threadReturnValue;
 }
 
+/**
+ * Set which CPUs the calling thread may run on.  Only works on Linux ( and
+ * Android ), elsewhere the OS picks.
+ * @param jl: The library context.
+ * @param cpus: The CPUs ( bit i = CPU i ), 0 to leave as is.
+ * @returns: 1 if set, 0 if not.
+**/
+u8_t jl_thread_pin(jl_t* jl, u64_t cpus) {
+	if(cpus == 0) return 1;
+#if defined(__linux__)
+	cpu_set_t set;
+	m_u8_t i;
+
+	CPU_ZERO(&set);
+	for(i = 0; i < 64; i++) if(cpus & (((u64_t)1) << i)) CPU_SET(i, &set);
+	if(sched_setaffinity(0, sizeof(set), &set) == 0) return 1;
+	JL_PRINT_DEBUG(jl, "Couldn't pin thread #%d: %s", jl_thread_current(jl),
+		strerror(errno));
+#endif
+	return 0;
+}
+
+/**
+ * Get which CPUs the calling thread may run on.
+ * @param jl: The library context.
+ * @returns: The CPUs ( bit i = CPU i ), 0 if unknown ( not Linux ).
+**/
+u64_t jl_thread_pinned(jl_t* jl) {
+	m_u64_t cpus = 0;
+#if defined(__linux__)
+	cpu_set_t set;
+	m_u8_t i;
+
+	if(sched_getaffinity(0, sizeof(set), &set)) return 0;
+	for(i = 0; i < 64; i++) if(CPU_ISSET(i, &set)) cpus |= ((u64_t)1) << i;
+#endif
+	return cpus;
+}
+
+/**
+ * Set the calling thread's priority.  On Linux ( and Android ) this is the
+ * thread's nice level, elsewhere it's SDL's low, normal or high priority.
+ * Raising priority may need permission from the OS.
+ * @param jl: The library context.
+ * @param nice: -20 ( most CPU time ) to 19 ( least ), 0 = default.
+ * @returns: 1 if set, 0 if not.
+**/
+u8_t jl_thread_nice(jl_t* jl, i8_t nice) {
+#if defined(__linux__)
+	// Each Linux thread has it's own nice level.
+	if(setpriority(PRIO_PROCESS, syscall(SYS_gettid), nice) == 0) return 1;
+	JL_PRINT_DEBUG(jl, "Couldn't set nice %d on thread #%d: %s", nice,
+		jl_thread_current(jl), strerror(errno));
+	return 0;
+#else
+	return SDL_SetThreadPriority(nice < 0 ? SDL_THREAD_PRIORITY_HIGH :
+		(nice > 0 ? SDL_THREAD_PRIORITY_LOW :
+		SDL_THREAD_PRIORITY_NORMAL)) == 0;
+#endif
+}
+
+/**
+ * Get the CPUs a kind of thread should run on, so the main, graphics & audio
+ * threads each get a CPU & job workers don't share them.  With 4 or more CPUs:
+ * main = CPU 0, graphics = CPU 1, audio = the last CPU & workers = the CPUs
+ * between.  Other threads get any CPU.  With fewer CPUs nothing is pinned.
+ *
+ * On Linux new threads start with their creator's CPUs.  Threads from
+ * jl_thread_new() undo that, & main & graphics are pinned after their start up
+ * ( so threads SDL or the GL driver make then don't inherit 1 CPU ), but
+ * threads SDL makes from main or graphics after that do start on their CPU.
+ * @param jl: The library context.
+ * @param role: Which kind of thread.
+ * @returns: The CPUs ( bit i = CPU i ), 0 = any.
+**/
+u64_t jl_thread_cpus(jl_t* jl, jl_thread_role_t role) {
+	m_i32_t cores = SDL_GetCPUCount();
+
+	// Too few to keep the threads apart.
+	if(cores < 4) return 0;
+	if(cores > 64) cores = 64;
+	switch(role) {
+		case JL_THREAD_MAIN: return 1;
+		case JL_THREAD_DRAW: return 2;
+		case JL_THREAD_AUDIO: return ((u64_t)1) << (cores - 1);
+		case JL_THREAD_ANY: return UINT64_MAX >> (64 - cores);
+		default: return (UINT64_MAX >> (64 - cores)) & ~((u64_t)3) &
+			~(((u64_t)1) << (cores - 1));
+	}
+}
+
 /**
  * Create a mutex ( lock for a thread's access to data )
  * @param jl: The library context.
@@ -103,6 +423,17 @@ SDL_mutex* jl_thread_mutex_new(jl_t *jl) {
 		jl_print(jl, "jl_thread_mutex_new: Couldn't create mutex");
 		exit(-1);
 	}
+#ifdef JL_THREAD_PROFILE
+	jl_thread_lock_t* lock;
+
+	// Don't count an old mutex's locks at the same address.
+	SDL_AtomicLock(&jl_thread_profile_lock__);
+	if((lock = jl_thread_profile_find__(mutex, 1))) {
+		jl_mem_clr(lock, sizeof(jl_thread_lock_t));
+		lock->stats.mutex = mutex;
+	}
+	SDL_AtomicUnlock(&jl_thread_profile_lock__);
+#endif
 	return mutex;
 }
 
@@ -112,7 +443,7 @@ SDL_mutex* jl_thread_mutex_new(jl_t *jl) {
  * @param mutex: The mutex created by jl_thread_mutex_new().
 **/
 void jl_thread_mutex_lock(jl_t *jl, SDL_mutex* mutex) {
-	if (SDL_LockMutex(mutex) != 0) {
+	if (jl_thread_mutex_lock__(mutex) != 0) {
 		jl_print(jl, "jl_thread_mutex_use: Couldn't lock mutex");
 		exit(-1);
 	}
@@ -124,7 +455,7 @@ void jl_thread_mutex_lock(jl_t *jl, SDL_mutex* mutex) {
  * @param mutex: The mutex created by jl_thread_mutex_new().
 **/
 void jl_thread_mutex_unlock(jl_t *jl, SDL_mutex* mutex) {
-	SDL_UnlockMutex(mutex);
+	jl_thread_mutex_unlock__(mutex);
 }
 
 /**
@@ -155,11 +486,11 @@ void jl_thread_mutex_use(jl_t *jl, SDL_mutex* mutex, jl_fnct fn_) {
 void jl_thread_mutex_cpy(jl_t *jl, SDL_mutex* mutex, void* src, void* dst,
 	u32_t size)
 {
-	if (SDL_LockMutex(mutex) == 0) {
+	if (jl_thread_mutex_lock__(mutex) == 0) {
 		// Copy data.
 		jl_mem_copyto(src, dst, size);
 		// Give up for other threads
-		SDL_UnlockMutex(mutex);
+		jl_thread_mutex_unlock__(mutex);
 	} else {
 		jl_print(jl, "jl_thread_mutex_use: Couldn't lock mutex");
 		exit(-1);
@@ -172,81 +503,291 @@ void jl_thread_mutex_cpy(jl_t *jl, SDL_mutex* mutex, void* src, void* dst,
  * @param mutex: The mutex to free (created by jl_thread_mutex_new())
 **/
 void jl_thread_mutex_old(jl_t* jl, SDL_mutex* mutex) {
+#ifdef JL_THREAD_PROFILE
+	jl_thread_lock_t* lock;
+
+	// Give the slot back, so the table doesn't fill with old mutexes.
+	SDL_AtomicLock(&jl_thread_profile_lock__);
+	if((lock = jl_thread_profile_find__(mutex, 0))) {
+		jl_mem_clr(lock, sizeof(jl_thread_lock_t));
+		lock->freed = 1;
+	}
+	SDL_AtomicUnlock(&jl_thread_profile_lock__);
+#endif
 	SDL_DestroyMutex(mutex);
 }
 
 /**
- * Create a thread communicator.
+ * Name a mutex in the profiler's reports.  Only does anything if
+ *	JL_THREAD_PROFILE is defined in "jl_me.h".
+ * @param jl: The library context.
+ * @param mutex: The mutex created by jl_thread_mutex_new().
+ * @param name: The name ( not copied, so keep it around ).
+**/
+void jl_thread_mutex_name(jl_t* jl, SDL_mutex* mutex, str_t name) {
+#ifdef JL_THREAD_PROFILE
+	jl_thread_lock_t* lock;
+
+	SDL_AtomicLock(&jl_thread_profile_lock__);
+	if((lock = jl_thread_profile_find__(mutex, 0))) lock->stats.name = name;
+	SDL_AtomicUnlock(&jl_thread_profile_lock__);
+#endif
+}
+
+/**
+ * Get the lock statistics of the mutexes, most time waited first.  Only
+ *	works if JL_THREAD_PROFILE is defined in "jl_me.h".
+ * @param stats: Where to copy the statistics.
+ * @param max: How many "stats" has room for.
+ * @returns: How many were copied ( 0 if not profiling ).
+**/
+u32_t jl_thread_profile_stats(jl_mutex_stats_t* stats, u32_t max) {
+#ifdef JL_THREAD_PROFILE
+	jl_mutex_stats_t all[JL_THREAD_PROFILE_MUTEXES];
+	m_u32_t i, used = 0;
+
+	// Take a snapshot, so sorting doesn't hold the lock.
+	SDL_AtomicLock(&jl_thread_profile_lock__);
+	for(i = 0; i < JL_THREAD_PROFILE_MUTEXES; i++) {
+		if(jl_thread_profile__[i].stats.count)
+			all[used++] = jl_thread_profile__[i].stats;
+	}
+	SDL_AtomicUnlock(&jl_thread_profile_lock__);
+	qsort(all, used, sizeof(jl_mutex_stats_t), jl_thread_profile_cmp__);
+	if(used > max) used = max;
+	jl_mem_copyto(all, stats, used * sizeof(jl_mutex_stats_t));
+	return used;
+#else
+	return 0;
+#endif
+}
+
+/**
+ * Print how often each mutex was locked & contended, how long threads waited
+ *	for it & how long it was held.  Only works if JL_THREAD_PROFILE is
+ *	defined in "jl_me.h".  This is also printed when JL_Lib quits.
+ * @param jl: The library context.
+**/
+void jl_thread_profile_print(jl_t* jl) {
+#ifdef JL_THREAD_PROFILE
+	jl_mutex_stats_t stats[JL_THREAD_PROFILE_MUTEXES];
+	u32_t used = jl_thread_profile_stats(stats, JL_THREAD_PROFILE_MUTEXES);
+	m_u32_t i, j;
+
+	// Print from the snapshot, so the table isn't read while it changes.
+	for(i = 0; i < used; i++) {
+		jl_mutex_stats_t* s = &stats[i];
+
+		jl_print(jl, "Mutex %s (%p): %llu locks, %llu contended, waited "
+			"%llu us ( max %llu us )", s->name ? s->name : "?",
+			s->mutex, (unsigned long long)s->count,
+			(unsigned long long)s->contended,
+			(unsigned long long)s->wait_total,
+			(unsigned long long)s->wait_max);
+		for(j = 0; j < 16; j++) {
+			if(s->holds[j]) jl_print(jl, "\tHeld %8llu+ us: %llu",
+				((unsigned long long)1) << j,
+				(unsigned long long)s->holds[j]);
+		}
+	}
+#else
+	jl_print(jl, "jl_thread_profile_print(): JL_THREAD_PROFILE isn't "
+		"defined");
+#endif
+}
+
+/**
+ * Create a thread communicator: a queue of packets from 1 sending thread to 1
+ * receiving thread.  Packets are received in the order they're sent, and
+ * neither side ever locks or waits on the other.
  * @param jl: The library context.
- * @param size: The size of the data.
+ * @param size: The size of each packet.
+ * @param count: How many packets can be sent without the other thread
+ *	receiving ( rounded up to a power of 2 ).
  * @returns: The thread communicator.
 **/
-jl_comm_t* jl_thread_comm_make(jl_t* jl, u32_t size) {
-	jl_comm_t* rtn = jl_memi(jl, sizeof(jl_comm_t));
-	m_u8_t i;
+jl_comm_t* jl_thread_comm_make(jl_t* jl, u32_t size, u32_t count) {
+	jl_comm_t* rtn = jl_mem_aligned(jl, sizeof(jl_comm_t), JL_MEM_ALIGN);
+	m_u32_t slots = 2;
 
-	rtn->lock = SDL_CreateMutex();
+	while(slots < count) slots *= 2;
+	SDL_AtomicSet(&rtn->tail, 0);
+	SDL_AtomicSet(&rtn->head, 0);
+	rtn->head_cache = rtn->tail_cache = 0;
+	SDL_AtomicSet(&rtn->waiting, 0);
+	SDL_AtomicSet(&rtn->woken, 0);
 	rtn->size = size;
-	rtn->pnum = 0;
-	for(i = 0; i < 16; i++) {
-		rtn->data[i] = jl_memi(jl, size);
+	rtn->mask = slots - 1;
+	rtn->data = jl_memi(jl, slots * size);
+	if((rtn->wake = SDL_CreateSemaphore(0)) == NULL) {
+		jl_print(jl, "jl_thread_comm_make: Couldn't create semaphore");
+		exit(-1);
 	}
 	return rtn;
 }
 
 /**
- * Send a message to another thread.  Up to 16 messages can be sent without the
- *	other thread responding.  If the 17th is trying to be sent, then the
- *	thread jl_thread_comm_send() is called on will be stalled.  It will wait
- *	until the other thread responds, and if it doesn't, the program will
- *	crash.
+ * Send packets to the other thread.  Only 1 thread may send on "comm".  The
+ * packets are published together, so the receiver sees them all at once.
  * @param jl: The library context.
  * @param comm: The thread communicator.
- * @param src: The data to send, must be same size as specified in
- *	jl_thread_comm_new().
+ * @param src: "count" packets, each the size given to jl_thread_comm_make().
+ * @param count: How many packets to send.
+ * @returns: How many packets were sent ( less than "count" if "comm" filled ).
 **/
-void jl_thread_comm_send(jl_t* jl, jl_comm_t* comm, const void* src) {
-	uint8_t stall = 0;
-	SDL_LockMutex(comm->lock);
-	// Copy to next packet location
-	jl_mem_copyto(src, comm->data[comm->pnum], comm->size);
-	// Advance number of packets.
-	comm->pnum++;
-	// If maxed out on packets, then stall.
-	if(comm->pnum == 16) {
-		JL_PRINT_DEBUG(jl,"WARNING: \"jl_thread_comm_send\" Stalling....");
-		stall = 1;
+u32_t jl_thread_comm_send_batch(jl_t* jl, jl_comm_t* comm, const void* src,
+	u32_t count)
+{
+	u32_t tail = SDL_AtomicGet(&comm->tail);
+	m_u32_t room = comm->mask + 1 - (tail - comm->head_cache);
+	m_u32_t i;
+
+	// Only look at the receiver's cache line when it seems full.
+	if(room < count) {
+		comm->head_cache = SDL_AtomicGet(&comm->head);
+		// Don't write slots before the receiver is done reading them.
+		SDL_MemoryBarrierAcquire();
+		room = comm->mask + 1 - (tail - comm->head_cache);
 	}
-	SDL_UnlockMutex(comm->lock);
-	// If 1 second passed, and still stalling, then quit.
-	while(stall) {
-		if(stall > 10) {
-			jl_print(jl, "Other thread wouldn't respond!");
-			exit(-1);
-		}
-		SDL_LockMutex(comm->lock);
-		if(comm->pnum != 16) break;
-		SDL_UnlockMutex(comm->lock);
-		SDL_Delay(100);
-		stall++;
+	if(count < room) room = count;
+	for(i = 0; i < room; i++) {
+		jl_mem_copyto((const uint8_t*)src + i * comm->size, comm->data +
+			((tail + i) & comm->mask) * comm->size, comm->size);
+	}
+	// Publish after the copies ( SDL_AtomicSet() is only an acquire
+	// barrier with GCC, so the release barrier is needed ).
+	if(room) {
+		SDL_MemoryBarrierRelease();
+		SDL_AtomicSet(&comm->tail, tail + room);
+		// Only make a system call if the receiver is asleep.
+		if(SDL_AtomicGet(&comm->waiting)) SDL_SemPost(comm->wake);
 	}
+	return room;
+}
+
+/**
+ * Send a packet to the other thread.  Only 1 thread may send on "comm".
+ * @param jl: The library context.
+ * @param comm: The thread communicator.
+ * @param src: The data to send, must be same size as specified in
+ *	jl_thread_comm_make().
+ * @returns: 1 if sent, 0 if "comm" is full ( the other thread hasn't received
+ *	enough packets ).
+**/
+u8_t jl_thread_comm_send(jl_t* jl, jl_comm_t* comm, const void* src) {
+	return jl_thread_comm_send_batch(jl, comm, src, 1);
 }
 
 /**
  * Process all of the packets in a thread communicator, which are sent from
- *	another thread.
+ *	another thread, in the order they were sent.  Only 1 thread may receive
+ *	on "comm".
  * @param jl: The library context.
  * @param comm: The thread communicator.
  * @param fn: The function that processes each packet ( parameters: jl_t*,
  *	void*, returns void).
+ * @returns: How many packets were processed, 0 if "comm" was empty.
+**/
+u32_t jl_thread_comm_recv(jl_t* jl, jl_comm_t* comm, jl_data_fnct fn) {
+	u32_t head = SDL_AtomicGet(&comm->head);
+	m_u32_t i, count;
+
+	comm->tail_cache = SDL_AtomicGet(&comm->tail);
+	// Don't read slots before the sender's copies are visible.
+	SDL_MemoryBarrierAcquire();
+	count = comm->tail_cache - head;
+	for(i = 0; i < count; i++)
+		fn(jl, comm->data + ((head + i) & comm->mask) * comm->size);
+	// Give the slots back after "fn" is done with them.
+	if(count) {
+		SDL_MemoryBarrierRelease();
+		SDL_AtomicSet(&comm->head, head + count);
+	}
+	return count;
+}
+
+/**
+ * Copy packets out of a thread communicator, in the order they were sent.
+ *	Only 1 thread may receive on "comm".
+ * @param jl: The library context.
+ * @param comm: The thread communicator.
+ * @param dst: Room for "count" packets.
+ * @param count: The most packets to receive.
+ * @returns: How many packets were received, 0 if "comm" was empty.
 **/
-void jl_thread_comm_recv(jl_t* jl, jl_comm_t* comm, jl_data_fnct fn) {
-	SDL_LockMutex(comm->lock);
-	while(comm->pnum != 0) {
-		fn(jl, comm->data[comm->pnum - 1]);
-		comm->pnum--;
+u32_t jl_thread_comm_recv_batch(jl_t* jl, jl_comm_t* comm, void* dst,
+	u32_t count)
+{
+	u32_t head = SDL_AtomicGet(&comm->head);
+	m_u32_t have = comm->tail_cache - head;
+	m_u32_t i;
+
+	// Only look at the sender's cache line when it seems empty.
+	if(have < count) {
+		comm->tail_cache = SDL_AtomicGet(&comm->tail);
+		have = comm->tail_cache - head;
 	}
-        SDL_UnlockMutex(comm->lock);
+	// Don't read slots before the sender's copies are visible.
+	SDL_MemoryBarrierAcquire();
+	if(count < have) have = count;
+	for(i = 0; i < have; i++) {
+		jl_mem_copyto(comm->data + ((head + i) & comm->mask) *
+			comm->size, (uint8_t*)dst + i * comm->size, comm->size);
+	}
+	// Give the slots back after they're copied out.
+	if(have) {
+		SDL_MemoryBarrierRelease();
+		SDL_AtomicSet(&comm->head, head + have);
+	}
+	return have;
+}
+
+/**
+ * Sleep until packets are sent on "comm", jl_thread_comm_wake() is called or
+ *	"timeout" milliseconds pass.  Only the receiving thread may wait.
+ * @param jl: The library context.
+ * @param comm: The thread communicator.
+ * @param timeout: The most milliseconds to wait ( SDL_MUTEX_MAXWAIT to wait
+ *	forever, 0 to not wait ).
+ * @returns: 1 if woken or packets are waiting, 0 if timed out.
+**/
+u8_t jl_thread_comm_wait(jl_t* jl, jl_comm_t* comm, u32_t timeout) {
+	u32_t head = SDL_AtomicGet(&comm->head);
+	m_u8_t rtn;
+
+	if(SDL_AtomicGet(&comm->tail) != head) return 1;
+	if(SDL_AtomicSet(&comm->woken, 0)) return 1;
+	if(timeout == 0) return 0;
+	// Say we're asleep, then check again so a send or wake can't be
+	// missed ( a CAS is a full barrier, SDL_AtomicSet() may not be ).
+	SDL_AtomicCAS(&comm->waiting, 0, 1);
+	if(SDL_AtomicGet(&comm->tail) != head ||
+		SDL_AtomicSet(&comm->woken, 0))
+	{
+		rtn = 1;
+	}else if(timeout == SDL_MUTEX_MAXWAIT) {
+		rtn = SDL_SemWait(comm->wake) == 0;
+	}else{
+		rtn = SDL_SemWaitTimeout(comm->wake, timeout) == 0;
+	}
+	SDL_AtomicSet(&comm->waiting, 0);
+	// A wake that posted also set "woken".
+	if(SDL_AtomicSet(&comm->woken, 0)) rtn = 1;
+	return rtn || SDL_AtomicGet(&comm->tail) != head;
+}
+
+/**
+ * Wake the receiving thread if it's in jl_thread_comm_wait(), without sending
+ *	a packet.  Any thread may call this.
+ * @param jl: The library context.
+ * @param comm: The thread communicator.
+**/
+void jl_thread_comm_wake(jl_t* jl, jl_comm_t* comm) {
+	// Set before checking "waiting", so a receiver about to sleep sees it.
+	SDL_AtomicCAS(&comm->woken, 0, 1);
+	// Only make a system call if the receiver is asleep, & only once, so
+	// extra wakes don't stop it from sleeping next time.
+	if(SDL_AtomicCAS(&comm->waiting, 1, 0)) SDL_SemPost(comm->wake);
 }
 
 /**
@@ -255,13 +796,8 @@ void jl_thread_comm_recv(jl_t* jl, jl_comm_t* comm, jl_data_fnct fn) {
  * @param comm: The thread communicator.
 **/
 void jl_thread_comm_kill(jl_t* jl, jl_comm_t* comm) {
-	m_u8_t i;
-
-	// Free the lock.
-	SDL_DestroyMutex(comm->lock);
-	// Free 16 packets.
-	for(i = 0; i < 16; i++) jl_mem(jl, comm->data[i], 0);
-	// Free main data structure.
+	SDL_DestroySemaphore(comm->wake);
+	jl_mem(jl, comm->data, 0);
 	jl_mem(jl, comm, 0);
 }
 
@@ -269,9 +805,55 @@ void jl_thread_comm_kill(jl_t* jl, jl_comm_t* comm) {
 // Internal functions
 //
 
+/**
+ * Get the calling thread's context.  This is a thread-local load, so it's
+ * cheap enough to call from every print & format.
+ * @param jl: The library context.
+ * @returns: The thread's context ( the main thread's if it wasn't made with
+ *	jl_thread_new() ).
+**/
+jl_ctx_t* jl_thread_get_safe__(jl_t* jl) {
+	return jl_thread_ctx__ ? jl_thread_ctx__ : jl_thread_main__;
+}
+
+/**
+ * Get the calling thread's own context.
+ * @param jl: The library context.
+ * @returns: The thread's context, or NULL if it wasn't made with
+ *	jl_thread_new() ( and isn't the main thread ).
+**/
+jl_ctx_t* jl_thread_get__(jl_t* jl) {
+	return jl_thread_ctx__;
+}
+
+/**
+ * Check if the calling thread is the main thread.  Unlike
+ * jl_thread_current() == 0, this is false on threads not made by JL_Lib.
+ * @param jl: The library context.
+ * @returns: 1 on the main thread, 0 on any other.
+**/
+u8_t jl_thread_is_main__(jl_t* jl) {
+	return jl_thread_ctx__ && jl_thread_ctx__ == jl_thread_main__;
+}
+
 void jl_thread_init__(jl_t* jl) {
-	uint8_t i;
+	m_u16_t id;
+
+	// Register the main thread as thread #0.
+	jl_thread_main__ = jl_thread_ctx_new__(jl, &id);
+	jl_thread_ctx__ = jl_thread_main__;
+	jl_thread_id__ = id;
+}
 
-	// Set all threads to null
-	for(i = 0; i < 16; i++) jl->jl_ctx[i].thread = NULL;
+void jl_thread_kill__(jl_t* jl) {
+	m_u16_t i;
+
+	for(i = 0; i < jl->thread_count; i++) {
+		jl_mem_ctx_free__(jl, jl->jl_ctx[i]);
+		jl_mem(jl, jl->jl_ctx[i], 0);
+	}
+	jl_mem(jl, jl->jl_ctx, 0);
+	jl->jl_ctx = NULL;
+	jl->thread_count = jl->thread_slots = 0;
+	jl_thread_main__ = jl_thread_ctx__ = NULL;
 }
@@ -12,12 +12,34 @@
 	#include <unistd.h>
 	#include <string.h>
 	#include <stdlib.h>
+	#include <stdarg.h>
 	#include <math.h>
 	#include <dirent.h>
 // Variable Map
 	#include "jl_vm.h"
 
 #define MAXFILELEN 1000 * 100000 //100,000 kb
+#define JL_MEM_FRAME_SIZE 65536 // Starting size of per-frame arenas.
+#define JL_MEM_FRAME_ALIGN 16 // Alignment of per-frame allocations.
+#define JL_MEM_FRAME_POISON 0xA5 // Debug: byte to fill old frames with.
+#define JL_MEM_FORMAT_SIZE 256 // Starting size of per-thread format buffers.
+#define JL_DATA_MIN_CAP 16 // Smallest space a growing data_t allocates.
+#define JL_TEXT_MIN_GAP 64 // Smallest buffer editable text allocates.
+#define JL_ROPE_SHIFT 20 // Ropes are made of 1 MiB chunks.
+#define JL_ROPE_CHUNK (1 << JL_ROPE_SHIFT)
+#define JL_JOB_QUEUE 1024 // Jobs each worker can queue ( a power of 2 ).
+#define JL_JOB_NAP_MS 10 // Longest a waiting thread sleeps between checks.
+#define JL_PAR_SERIAL 4096 // Smaller ranges run serially in jl_par_*().
+#define JL_PAR_GRAIN 256 // Smallest automatic grain for jl_par_*().
+#define JL_PAR_SPLIT 4 // Chunks for each thread, to balance uneven work.
+#define JL_MODE_BUDGET 8 // Milliseconds of work a frame gives yielding modes.
+#define JL_PRINT_LINE 248 // Longest line jl_print() queues, with it's NUL.
+#define JL_PRINT_RING 512 // Lines each thread can queue ( a power of 2 ).
+#define JL_PRINT_FLUSH_MS 50 // Longest the print writer thread sleeps.
+#define JL_PRINT_FILE_MAX (1 << 20) // Log file size that moves it to ".old".
+#define JL_PRINT_SINKS 8 // Max # of functions added with jl_print_sink_add().
+#define JL_MEM_SHRINK_MAX 16 // Max # of registered shrink callbacks.
+#define JL_MEM_RANDOM_SEED 1 // Default seed ( see jl_mem_random_seed() ).
 
 //resolutions
 #define JGR_STN 0 //standard 1280 by 960
@@ -52,9 +74,35 @@ char *jl_gem(void);
 uint32_t jl_gem_size(void);
 
 // Main - Prototypes
+	void *jl_mem__(jl_t* jl, void *a, u64_t size, jl_mem_tag_t tag);
+	void *jl_memi__(jl_t* jl, u64_t size, jl_mem_tag_t tag);
+	void *jl_mem_aligned__(jl_t* jl, u64_t size, u32_t align,
+		jl_mem_tag_t tag);
+	void *jl_mem_large__(jl_t* jl, u64_t size, jl_mem_tag_t tag);
+	void jl_mem_profile_frame__(void);
+	void jl_mem_pressure__(jl_t* jl);
+	str_t jl_mem_vformat__(jl_t* jl, char** buffer, m_u32_t* size,
+		str_t format, va_list arglist);
+	void jl_mem_random_init__(jl_ctx_t* ctx, u16_t id);
+	void jl_mem_ctx_free__(jl_t* jl, jl_ctx_t* ctx);
+	#ifdef JL_MEM_PROFILE
+		#define jl_mem__(...) JL_MEM_SITE(jl_mem__(__VA_ARGS__))
+		#define jl_memi__(...) JL_MEM_SITE(jl_memi__(__VA_ARGS__))
+		#define jl_mem_aligned__(...) \
+			JL_MEM_SITE(jl_mem_aligned__(__VA_ARGS__))
+		#define jl_mem_large__(...) \
+			JL_MEM_SITE(jl_mem_large__(__VA_ARGS__))
+	#endif
 	double jl_sdl_seconds_past__(jl_t* jl);
 	str_t jl_file_convert__(jl_t* jl, str_t filename);
+	uint8_t* jl_rope_tail__(jl_t* jl, jl_rope_t* rope, m_u32_t* room);
 	jl_ctx_t* jl_thread_get_safe__(jl_t* jl);
+	jl_ctx_t* jl_thread_get__(jl_t* jl);
+	u8_t jl_thread_is_main__(jl_t* jl);
+	u8_t jl_job_help__(jl_t* jl);
+	void jl_job_nap__(jl_t* jl, SDL_atomic_t* value, int until);
+	void jl_async_update__(jl_t* jl);
+	void jl_mode_loop__(jl_t* jl);
 
 	// LIB INITIALIZATION fn(Context)
 	void _jl_cm_init(jvct_t* _jl);
@@ -62,6 +110,7 @@ uint32_t jl_gem_size(void);
 	jvct_t* jl_mem_init__(void);
 	void jl_print_init__(jl_t* jl);
 	void jl_thread_init__(jl_t* jl);
+	void jl_job_init__(jl_t* jl);
 	void jl_mode_init__(jl_t* jl);
 	void jl_sdl_init__(jl_t* jl);
 
@@ -69,6 +118,9 @@ uint32_t jl_gem_size(void);
 	void jl_mem_kill__(jvct_t* jprg);
 	void jl_file_kill__(jvct_t * _jl);
 	void jl_print_kill__(jl_t* jl);
+	void jl_thread_kill__(jl_t* jl);
+	void jl_job_kill__(jl_t* jl);
+	void jl_async_kill__(jl_t* jl);
 
 	// LIB THREAD INITS
-	void jl_print_init_thread__(jl_t* jl, u8_t thread_id);
+	void jl_print_init_thread__(jl_t* jl, jl_ctx_t* ctx);
@@ -8,7 +8,6 @@ typedef struct {
 
 	// Memory
 	struct {
-		char buffer[256];
 		m_u8_t status;
 		m_u64_t usedmem;
 	}me;
@@ -26,7 +25,7 @@ typedef struct {
 		void *newfiledata;
 		uint64_t newfilesize;
 		uint8_t prompt;
-		data_t* promptstring;
+		jl_text_t* promptstring;
 		data_t* separator;
 
 		struct{
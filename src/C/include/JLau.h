@@ -8,11 +8,14 @@
 typedef struct {
 	Mix_Music *_MUS;
 	char _VOL;
+	const void *_DAT; // Encoded music, to reload after a shrink.
+	uint32_t _SIZ; // Size of "_DAT"
 }jlau_jmus_t__;
 
 typedef struct{
 	jl_t* jl;
 	uint32_t idis; //Which music to play next
+	uint32_t iplay; //Which music was last started ( may still be fading )
 	uint8_t sofi; //Seconds Of Fade In
 	uint8_t sofo; //Seconds Of Fade Out
 	int total; //Music Stack Maximum Music pieces
@@ -30,6 +33,7 @@ uint8_t jlau_mus_playing(void);
 void jlau_panning(uint8_t left, uint8_t toCenter);
 void jlau_panning_default(void);
 void jlau_add_audio(jlau_t* jlau, str_t pzipfile, uint16_t pigid);
+void jlau_add_audio_async(jlau_t* jlau, str_t pzipfile, uint16_t pigid);
 jlau_t* jlau_init(jl_t* jl);
 void jlau_kill(jlau_t* jlau);
 
@@ -33,7 +33,6 @@ typedef struct {
 	// Render Area
 	uint32_t gl;	// GL Vertex Buffer Object [ 0 = Not Enabled ]
 	float ar;	// Aspect Ratio: h:w
-	float* cv;	// Converted Vertices
 }jl_pr_t;
 
 // Collision Box.
@@ -50,10 +49,9 @@ typedef struct{
 	uint8_t rs;	// Rendering Style 0=GL_TRIANGLE_FAN 1=GL_TRIANGLES
 	uint32_t gl;	// GL Vertex Buffer Object [ 0 = Not Enabled ]
 	uint32_t vc;	// # of Vertices
-	float* cv;	// Converted Vertices
 	uint32_t bt;	// Buffer for Texture coordinates or Color Vertices.
 	// Coloring:
-	jl_ccolor_t* cc;// Converted Colors [ NULL = Texturing Instead ]
+	uint8_t cc;	// Has Converted Colors [ 0 = Texturing Instead ]
 	// Texturing:
 	uint32_t tx;	// ID to texture.
 	float a;	// Converted Alpha.
@@ -83,15 +81,24 @@ typedef struct {
 	m_f32_t size; // The Size
 }jl_font_t;
 
+// A sprite's collision box & size, as published to the draw thread.
 typedef struct{
-	SDL_mutex* mutex;	// The mutex for threads to use sprite.
+	jl_rect_t cb;		// Collision Box
+	float rh, rw;		// Real Height & Width
+}jl_sprite_state_t;
+
+typedef struct{
+	SDL_atomic_t seq;	// Odd while "state" is being published.
+	SDL_SpinLock lock;	// Lock for threads publishing "state".
+	jl_sprite_state_t state;// Last published "cb", "rh" & "rw".
 	jl_rect_t cb;		// Collision Box
 	float rh, rw;		// Real Height & Width
 	void* ctx;		// The sprite's context.
 	void* loop;		// (jlgr_sprite_fnt) Loop function
 	void* draw;		// (jlgr_sprite_fnt) Draw function
-	uint8_t update;		// Whether sprite should redraw or not.
+	SDL_atomic_t update;	// Whether sprite should redraw or not.
 	jl_pr_t *pr;		// Pre-renderer.
+	float prh, prw;		// Size "pr" was made for ( draw thread only ).
 }jl_sprite_t;
 
 typedef void(*jlgr_sprite_fnt)(jl_t* ctx, jl_sprite_t* spr);
@@ -131,7 +138,7 @@ typedef struct{
 	jl_font_t font;
 	jl_sprite_t* mouse; //jl_sprite_t: Sprite to represent mouse pointer
 
-	uint8_t thread; // Graphical Thread ID.
+	uint16_t thread; // Graphical Thread ID.
 	SDL_mutex* mutex; // Mutex to lock wshare structure.
 	jl_comm_t* comm2draw; // thread communication variable.
 	jl_comm_t* comm2main; // commition variable for thread communication.
@@ -186,6 +193,8 @@ typedef struct{
 		m_u8_t rtn;
 		jl_fnct fn;
 		jlgr_redraw_t redraw;
+		SDL_atomic_t ondemand; // Only redraw for packets & jlgr_redraw()
+		SDL_atomic_t request; // Set by jlgr_redraw().
 	} draw;
 
 	// Window Info
@@ -303,7 +312,7 @@ typedef struct{
 			m_u16_t i;
 			m_u8_t c;
 		}msge;
-		data_t* textbox_string;
+		jl_text_t* textbox_string;
 	}gr;
 
 	// Window Management
@@ -330,13 +339,16 @@ typedef void(*jlgr_input_fnct)(jlgr_t* jlgr, jlgr_input_t input);
 jlgr_t* jlgr_init(jl_t* jl, u8_t fullscreen, jl_fnct fn_);
 void jlgr_loop_set(jlgr_t* jlgr, jl_fnct onescreen, jl_fnct upscreen,
 	jl_fnct downscreen, jl_fnct resize);
+void jlgr_draw_ondemand(jlgr_t* jlgr, u8_t ondemand);
+void jlgr_redraw(jlgr_t* jlgr);
 void jlgr_loop(jlgr_t* jlgr);
 void jlgr_kill(jlgr_t* jlgr);
 
 // JLGRsprite.c
 void jlgr_sprite_dont(jl_t* jl, jl_sprite_t* sprite);
 void jlgr_sprite_redraw(jlgr_t* jlgr, jl_sprite_t *spr);
-void jlgr_sprite_resize(jlgr_t* jlgr, jl_sprite_t *spr, jl_rect_t* rc);
+void jlgr_sprite_resize(jlgr_t* jlgr, jl_sprite_t *spr);
+void jlgr_sprite_setrect(jlgr_t* jlgr, jl_sprite_t *spr, jl_rect_t rc);
 void jlgr_sprite_loop(jlgr_t* jlgr, jl_sprite_t *spr);
 void jlgr_sprite_draw(jlgr_t* jlgr, jl_sprite_t *spr);
 jl_sprite_t * jlgr_sprite_new(jlgr_t* jlgr, jl_rect_t rc,
@@ -344,6 +356,9 @@ jl_sprite_t * jlgr_sprite_new(jlgr_t* jlgr, jl_rect_t rc,
 u8_t jlgr_sprite_collide(jlgr_t* jlgr,
 	jl_sprite_t *sprite1, jl_sprite_t *sprite2);
 void* jlgr_sprite_getcontext(jl_sprite_t *sprite1);
+void jlgr_sprite_publish(jlgr_t* jlgr, jl_sprite_t *spr);
+jl_sprite_state_t jlgr_sprite_state(jl_sprite_t *spr);
+void jlgr_sprite_stats(jlgr_t* jlgr, m_u64_t* unlocked, m_u64_t* retries);
 
 // JLGRmenu.c
 void jlgr_menu_toggle(jlgr_t* jlgr);
@@ -379,6 +394,10 @@ void jlgr_draw_int(jlgr_t* jlgr, i64_t num, jl_vec3_t loc, jl_font_t f);
 void jlgr_draw_float(jlgr_t* jlgr, f64_t num, u8_t dec, jl_vec3_t loc,
 	jl_font_t f);
 void jlgr_draw_text_area(jlgr_t* jlgr, jl_sprite_t * spr, str_t txt);
+void jlgr_draw_text_gap(jlgr_t* jlgr, const jl_text_t* text, jl_vec3_t loc,
+	jl_font_t f);
+void jlgr_draw_text_area_gap(jlgr_t* jlgr, jl_sprite_t * spr,
+	const jl_text_t* text);
 void jlgr_draw_text_sprite(jlgr_t* jlgr,jl_sprite_t * spr, str_t txt);
 void jlgr_draw_ctxt(jlgr_t* jlgr, char *str, float yy, uint8_t* color);
 void jlgr_draw_msge(jlgr_t* jlgr, u16_t g, u16_t i, u8_t c,
@@ -390,7 +409,7 @@ void jlgr_slidebtn_loop(jlgr_t* jlgr, jl_sprite_t * spr, float defaultx,
 void jlgr_glow_button_draw(jlgr_t* jlgr, jl_sprite_t * spr,
 	char *txt, jlgr_input_fnct prun);
 uint8_t jlgr_draw_textbox(jlgr_t* jlgr, float x, float y, float w,
-	float h, data_t* *string);
+	float h, jl_text_t* *string);
 jl_sprite_t* jlgr_gui_slider(jlgr_t* jlgr, jl_rect_t rectangle,
 		u8_t isdouble, m_f32_t* x1, m_f32_t* x2);
 void jlgr_notify(jlgr_t* jlgr, str_t notification);
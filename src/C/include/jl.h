@@ -21,6 +21,7 @@
 #define JL_IMG_HEADER "JLVM0:JYMJ\0" // File format for images
 //1=format,4=size,x=data
 #define JL_IMG_SIZE_FLS 5 // How many bytes start for images.
+#define JL_MEM_ALIGN 64 // Alignment for pixel/vertex buffers ( a cache line )
 
 void jl_dont(jl_t* jl);
 void* jl_get_context(jl_t* jl);
@@ -30,14 +31,29 @@ int jl_start(jl_fnct fnc_init_, jl_fnct fnc_kill_, str_t name, u64_t ctx_size);
 void *jl_mem(jl_t* jl, void *a, u64_t size);
 void *jl_memi(jl_t* jl, u64_t size);
 void *jl_mem_copy(jl_t* jl, const void *src, u64_t size);
+void *jl_mem_aligned(jl_t* jl, u64_t size, u32_t align);
+void *jl_mem_large(jl_t* jl, u64_t size);
+void jl_mem_large_free(jl_t* jl, void* mem);
 u64_t jl_mem_tbiu(void);
+void jl_mem_stats(jl_mem_stats_t* stats);
+void jl_mem_budget(jl_t* jl, u64_t soft, u64_t hard);
+void jl_mem_shrink_add(jl_t* jl, jl_mem_shrink_fnt fn, void* data);
+void jl_mem_shrink_remove(jl_t* jl, jl_mem_shrink_fnt fn, void* data);
+u64_t jl_mem_shrink(jl_t* jl, u64_t bytes);
 void jl_mem_leak_init(jl_t* jl);
 void jl_mem_leak_fail(jl_t* jl, str_t fn_name);
 void jl_mem_clr(void* mem, u64_t size);
 void jl_mem_copyto(const void* src, void* dst, u64_t size);
 str_t jl_mem_format(jl_t* jl, str_t format, ... );
-u32_t jl_mem_random_int(u32_t a);
+void jl_mem_random_seed(jl_t* jl, u64_t seed);
+u32_t jl_mem_random_int(jl_t* jl, u32_t a);
+f32_t jl_mem_random_float(jl_t* jl);
+void jl_mem_random_fill(jl_t* jl, m_u32_t* buffer, u32_t count);
 void *jl_mem_temp(jl_t* jl, void *mem);
+void *jl_mem_frame_alloc(jl_t* jl, u32_t size);
+void jl_mem_frame_reset(jl_t* jl);
+void jl_mem_profile_print(jl_t* jl);
+u8_t jl_mem_site__(str_t file, i32_t line);
 
 // "JLdata_t.c"
 void jl_data_clear(jl_t* jl, data_t* pa);
@@ -54,14 +70,118 @@ void jl_data_saveto(data_t* pstr, u32_t varsize, const void* var);
 void jl_data_add_byte(data_t* pstr, u8_t pvalue);
 void jl_data_delete_byte(jl_t *jl, data_t* pstr);
 void jl_data_resize(jl_t *jl, data_t* pstr, u32_t newsize);
+void jl_data_reserve(jl_t *jl, data_t* pstr, u32_t cap);
+void jl_data_shrink(jl_t *jl, data_t* pstr);
 void jl_data_insert_byte(jl_t *jl, data_t* pstr, uint8_t pvalue);
 void jl_data_insert_data(jl_t *jl, data_t* pstr, void* data, u32_t size);
 char* jl_data_tostring(jl_t* jl, data_t* a);
+void jl_data_format(jl_t* jl, data_t* a, str_t format, ... );
 u8_t jl_data_test_next(data_t* script, str_t particle);
 data_t* jl_data_read_upto(jl_t* jl, data_t* script, u8_t end, u32_t psize);
+jl_view_t jl_view_make(const void* data, u32_t size);
+jl_view_t jl_data_view(const data_t* a);
+jl_view_t jl_data_read_until(data_t* script, u8_t end);
+u8_t jl_data_match(data_t* script, str_t particle);
+void jl_data_skip_space(data_t* script);
+u8_t jl_data_split(data_t* script, u8_t delim, jl_view_t* field);
+
+// "JLtext.c"
+jl_text_t* jl_text_make(jl_t* jl, str_t string);
+void jl_text_free(jl_t* jl, jl_text_t* text);
+u32_t jl_text_length(const jl_text_t* text);
+u32_t jl_text_cursor(const jl_text_t* text);
+void jl_text_seek(jl_text_t* text, u32_t curs);
+void jl_text_insert_data(jl_t* jl, jl_text_t* text, const void* data,
+	u32_t size);
+void jl_text_insert(jl_t* jl, jl_text_t* text, u8_t byte);
+void jl_text_delete(jl_text_t* text);
+void jl_text_backspace(jl_text_t* text);
+str_t jl_text_part(const jl_text_t* text, u8_t part, m_u32_t* size);
+str_t jl_text_string(jl_t* jl, jl_text_t* text);
+
+// "JLrope.c"
+jl_rope_t* jl_rope_make(jl_t* jl);
+void jl_rope_free(jl_t* jl, jl_rope_t* rope);
+void jl_rope_append(jl_t* jl, jl_rope_t* rope, const void* data, u64_t size);
+void jl_rope_seek(jl_rope_t* rope, u64_t curs);
+jl_view_t jl_rope_chunk(jl_rope_t* rope);
+u64_t jl_rope_read(jl_rope_t* rope, void* dst, u64_t size);
+u8_t jl_rope_byte(jl_rope_t* rope);
+u32_t jl_rope_window(jl_t* jl, jl_rope_t* rope, data_t* window, u32_t size);
+
+// "JLjob.c"
+void jl_job_run(jl_t* jl, jl_data_fnct fn, void* data,
+	jl_job_counter_t* counter);
+void jl_job_wait(jl_t* jl, jl_job_counter_t* counter);
+u8_t jl_job_done(jl_job_counter_t* counter);
+u16_t jl_job_workers(jl_t* jl);
+
+// "JLpar.c"
+void jl_par_for(jl_t* jl, u32_t count, u32_t grain, jl_par_fnt fn,
+	void* data);
+void jl_par_transform(jl_t* jl, const void* src, void* dst, u32_t count,
+	u32_t src_size, u32_t dst_size, jl_par_map_fnt fn, void* data);
+void jl_par_reduce(jl_t* jl, const void* src, u32_t count, u32_t size,
+	void* result, jl_par_reduce_fnt fn, void* data);
+void jl_par_sort(jl_t* jl, void* base, u32_t count, u32_t size,
+	jl_par_cmp_fnt cmp);
+
+// "JLasync.c"
+jl_future_t* jl_async(jl_t* jl, jl_async_fnt fn, void* arg);
+u8_t jl_future_poll(jl_future_t* future);
+void* jl_future_wait(jl_t* jl, jl_future_t* future);
+void jl_future_then(jl_t* jl, jl_future_t* future, jl_future_fnt fn,
+	void* data);
+
+// "JLstream.c"
+jl_stream_t jl_stream_make(jl_t* jl, data_t* data);
+void jl_stream_write(jl_stream_t* stream, const void* src, u32_t size);
+u8_t jl_stream_read(jl_stream_t* stream, void* dst, u32_t size);
+void jl_stream_write_u8(jl_stream_t* stream, u8_t value);
+void jl_stream_write_u16(jl_stream_t* stream, u16_t value);
+void jl_stream_write_u32(jl_stream_t* stream, u32_t value);
+void jl_stream_write_u64(jl_stream_t* stream, u64_t value);
+void jl_stream_write_f32(jl_stream_t* stream, f32_t value);
+void jl_stream_write_f64(jl_stream_t* stream, f64_t value);
+u8_t jl_stream_read_u8(jl_stream_t* stream);
+u16_t jl_stream_read_u16(jl_stream_t* stream);
+u32_t jl_stream_read_u32(jl_stream_t* stream);
+u64_t jl_stream_read_u64(jl_stream_t* stream);
+f32_t jl_stream_read_f32(jl_stream_t* stream);
+f64_t jl_stream_read_f64(jl_stream_t* stream);
+void jl_stream_write_uvar(jl_stream_t* stream, u64_t value);
+u64_t jl_stream_read_uvar(jl_stream_t* stream);
+void jl_stream_write_ivar(jl_stream_t* stream, i64_t value);
+i64_t jl_stream_read_ivar(jl_stream_t* stream);
+void jl_stream_write_blob(jl_stream_t* stream, const void* src, u32_t size);
+jl_view_t jl_stream_read_blob(jl_stream_t* stream);
+void jl_stream_write_array(jl_stream_t* stream, const void* src, u32_t count,
+	u8_t size);
+u8_t jl_stream_read_array(jl_stream_t* stream, void* dst, u32_t count,
+	u8_t size);
+
+// Allocation profiling: remember the outermost call site of an allocation.
+#ifdef JL_MEM_PROFILE
+	#define JL_MEM_SITE(call) ({					\
+		uint8_t jl_mem_site_set__ = jl_mem_site__(__FILE__, __LINE__);\
+		__typeof__(call) jl_mem_site_rtn__ = (call);		\
+		if(jl_mem_site_set__) jl_mem_site__(NULL, 0);		\
+		jl_mem_site_rtn__;					\
+	})
+	#define jl_mem(...) JL_MEM_SITE(jl_mem(__VA_ARGS__))
+	#define jl_memi(...) JL_MEM_SITE(jl_memi(__VA_ARGS__))
+	#define jl_mem_copy(...) JL_MEM_SITE(jl_mem_copy(__VA_ARGS__))
+	#define jl_mem_aligned(...) JL_MEM_SITE(jl_mem_aligned(__VA_ARGS__))
+	#define jl_mem_large(...) JL_MEM_SITE(jl_mem_large(__VA_ARGS__))
+	#define jl_data_make(...) JL_MEM_SITE(jl_data_make(__VA_ARGS__))
+	#define jl_data_mkfrom_str(...) \
+		JL_MEM_SITE(jl_data_mkfrom_str(__VA_ARGS__))
+	#define jl_data_mkfrom_data(...) \
+		JL_MEM_SITE(jl_data_mkfrom_data(__VA_ARGS__))
+#endif
 
 // "cl.c"
-void jl_cl_list_alphabetize(struct cl_list *list);
+void jl_cl_list_alphabetize(jl_t* jl, struct cl_list *list);
 
 // "JLmode.c"
 void jl_mode_set(jl_t* jl, u16_t mode, jl_mode_t loops);
@@ -69,13 +189,31 @@ void jl_mode_override(jl_t* jl, jl_mode_t loops);
 void jl_mode_reset(jl_t* jl);
 void jl_mode_switch(jl_t* jl, u16_t mode);
 void jl_mode_exit(jl_t* jl);
+u8_t jl_mode_time_up(jl_t* jl);
+// Let a mode's init or loop stop part way & continue next frame ( stackless:
+// local variables are lost at JL_MODE_YIELD(), so keep state in the program's
+// context, & don't yield from inside another switch ).
+#define JL_MODE_BEGIN(jl) switch((jl)->mode.resume) { case 0:
+#define JL_MODE_YIELD(jl) do {						\
+		(jl)->mode.resume = __LINE__; return; case __LINE__:;	\
+	} while(0)
+#define JL_MODE_END(jl) } (jl)->mode.resume = 0
 
 // "JLprint.c"
 void jl_print_set(jl_t* jl, jl_print_fnt fn_);
 void jl_print(jl_t* jl, str_t format, ... );
-void jl_print_function(jl_t* jl, str_t fn_name);
-void jl_print_return(jl_t* jl, str_t fn_name);
+#ifdef JL_PRINT_NO_STACK
+	#define jl_print_function(jl, fn_name)
+	#define jl_print_return(jl, fn_name)
+#else
+	void jl_print_function(jl_t* jl, str_t fn_name);
+	void jl_print_return(jl_t* jl, str_t fn_name);
+#endif
 void jl_print_stacktrace(jl_t* jl);
+u8_t jl_print_sink_add(jl_t* jl, jl_print_fnt fn);
+void jl_print_sink_remove(jl_t* jl, jl_print_fnt fn);
+void jl_print_flush(jl_t* jl);
+u32_t jl_print_dropped(jl_t* jl);
 #ifdef DEBUG
 	#define JL_PRINT_DEBUG(jl, ...) jl_print(jl, __VA_ARGS__)
 #else
@@ -89,20 +227,33 @@ void jl_file_rm(jl_t* jl, str_t filename);
 void jl_file_save(jl_t* jl, const void *file, const char *name,
 	uint32_t bytes);
 data_t* jl_file_load(jl_t* jl, str_t file_name);
+void jl_file_save_rope(jl_t* jl, jl_rope_t* rope, str_t name);
+jl_rope_t* jl_file_load_rope(jl_t* jl, str_t file_name);
 char jl_file_pk_save(jl_t* jl, str_t packageFileName, str_t fileName,
 	void *data, uint64_t dataSize);
 data_t* jl_file_pk_load_fdata(jl_t* jl, data_t* data, str_t file_name);
+jl_rope_t* jl_file_pk_load_rope(jl_t* jl, data_t* data, str_t file_name);
+jl_future_t* jl_file_pk_load_async(jl_t* jl, str_t packageFileName,
+	str_t filename);
 data_t* jl_file_pk_load(jl_t* jl, const char *packageFileName,
 	const char *filename);
 data_t* jl_file_media(jl_t* jl, str_t Fname, str_t pzipfile,
 	void *pdata, uint64_t psize);
+jl_future_t* jl_file_media_async(jl_t* jl, str_t Fname, str_t pzipfile,
+	void *pdata, uint64_t psize);
 u8_t jl_file_mkdir(jl_t* jl, str_t path);
 str_t jl_file_get_resloc(jl_t* jl, str_t prg_folder, str_t fname);
 
 // "JLthread.c"
-uint8_t jl_thread_new(jl_t *jl, str_t name, SDL_ThreadFunction fn);
-uint8_t jl_thread_current(jl_t *jl);
-int32_t jl_thread_old(jl_t *jl, u8_t threadnum);
+uint16_t jl_thread_new(jl_t *jl, str_t name, SDL_ThreadFunction fn);
+uint16_t jl_thread_current(jl_t *jl);
+int32_t jl_thread_old(jl_t *jl, u16_t threadnum);
+uint16_t jl_thread_new_opt(jl_t *jl, str_t name, SDL_ThreadFunction fn,
+	const jl_thread_opt_t* opt);
+u8_t jl_thread_pin(jl_t* jl, u64_t cpus);
+u64_t jl_thread_pinned(jl_t* jl);
+u8_t jl_thread_nice(jl_t* jl, i8_t nice);
+u64_t jl_thread_cpus(jl_t* jl, jl_thread_role_t role);
 SDL_mutex* jl_thread_mutex_new(jl_t *jl);
 void jl_thread_mutex_lock(jl_t *jl, SDL_mutex* mutex);
 void jl_thread_mutex_unlock(jl_t *jl, SDL_mutex* mutex);
@@ -110,9 +261,18 @@ void jl_thread_mutex_use(jl_t *jl, SDL_mutex* mutex, jl_fnct fn_);
 void jl_thread_mutex_cpy(jl_t *jl, SDL_mutex* mutex, void* src,
 	void* dst, u32_t size);
 void jl_thread_mutex_old(jl_t *jl, SDL_mutex* mutex);
-jl_comm_t* jl_thread_comm_make(jl_t* jl, u32_t size);
-void jl_thread_comm_send(jl_t* jl, jl_comm_t* comm, const void* src);
-void jl_thread_comm_recv(jl_t* jl, jl_comm_t* comm, jl_data_fnct fn);
+void jl_thread_mutex_name(jl_t *jl, SDL_mutex* mutex, str_t name);
+u32_t jl_thread_profile_stats(jl_mutex_stats_t* stats, u32_t max);
+void jl_thread_profile_print(jl_t* jl);
+jl_comm_t* jl_thread_comm_make(jl_t* jl, u32_t size, u32_t count);
+u32_t jl_thread_comm_send_batch(jl_t* jl, jl_comm_t* comm, const void* src,
+	u32_t count);
+u8_t jl_thread_comm_send(jl_t* jl, jl_comm_t* comm, const void* src);
+u32_t jl_thread_comm_recv(jl_t* jl, jl_comm_t* comm, jl_data_fnct fn);
+u32_t jl_thread_comm_recv_batch(jl_t* jl, jl_comm_t* comm, void* dst,
+	u32_t count);
+u8_t jl_thread_comm_wait(jl_t* jl, jl_comm_t* comm, u32_t timeout);
+void jl_thread_comm_wake(jl_t* jl, jl_comm_t* comm);
 void jl_thread_comm_kill(jl_t* jl, jl_comm_t* comm);
 
 // "JLsdl.c"
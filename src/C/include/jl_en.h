@@ -28,6 +28,17 @@ typedef enum{
 	JL_ERR_NULL, //Something requested is empty/null
 }jl_err_t;
 
+// Memory accounting tags ( which subsystem allocated the memory ).
+typedef enum{
+	JL_MEM_TAG_USER, // Program's memory & anything untagged.
+	JL_MEM_TAG_GL, // Graphics: OpenGL & window objects.
+	JL_MEM_TAG_SG, // Graphics: Image loading.
+	JL_MEM_TAG_FILE, // File system & packages.
+	JL_MEM_TAG_AU, // Audio.
+	JL_MEM_TAG_DATA, // data_t strings.
+	JL_MEM_TAG_MAX,
+}jl_mem_tag_t;
+
 typedef enum{
 	JL_GL_SLPR_TEX, //Texture Shader
 	JL_GL_SLPR_PRM, //Pre-Blended Texture Shader
@@ -17,6 +17,14 @@
 	#define DEBUG
 #endif
 
+// Uncomment to record where memory is allocated ( see jl_mem_profile_print() )
+// #define JL_MEM_PROFILE
+// Uncomment to time mutex waits & holds ( see jl_thread_profile_print() )
+// #define JL_THREAD_PROFILE
+// Uncomment to make jl_print_function() & jl_print_return() do nothing ( the
+// names of open blocks aren't tracked or printed in stacktraces )
+// #define JL_PRINT_NO_STACK
+
 //Platform Declarations
 #define JL_PLAT_COMPUTER 0 //PC/MAC
 #define JL_PLAT_PHONE 1 //ANDROID/IPHONE
@@ -38,20 +38,100 @@ typedef const char* str_t;	// String Constant
 typedef char m_chr_t;		// Character Modifiable
 typedef char* m_str_t;		// String Modifiable
 
-//4 bytes of information about the string are included
+//Information about the string is included ( always NUL terminated ).
 typedef struct{
 	uint8_t* data; //Actual String
-	uint32_t size; //Allocated Space In String
+	uint32_t size; //Length Of String ( not counting the NUL )
 	uint32_t curs; //Cursor In String
+	uint32_t cap; //Allocated Space In String ( not counting the NUL )
 }data_t;
 
+// A borrowed slice of memory ( doesn't own "data", so isn't freed ).
 typedef struct{
-	SDL_mutex *lock;	/** The mutex lock on the "data" */
-	m_u8_t pnum;		/** Number of packets in structure (upto 16 ) */
-	m_u32_t size;		/** Size of "data" */
-	void* data[16];		/** The data attached to the mutex */
+	const uint8_t* data; //Start Of The Slice
+	uint32_t size; //Length Of The Slice
+	uint32_t curs; //Cursor In The Slice
+}jl_view_t;
+
+// Editable text ( see JLtext.c ).
+typedef struct{
+	uint8_t* data;	/** Text, then the gap, then more text */
+	uint32_t size;	/** Size of "data" in bytes ( not counting a NUL ) */
+	uint32_t gap;	/** Where the gap starts */
+	uint32_t gape;	/** Where the gap ends */
+	uint32_t curs;	/** Cursor in the text */
+}jl_text_t;
+
+// Data too big for a data_t, in fixed-size chunks ( see JLrope.c ).
+typedef struct{
+	uint8_t** chunks;	/** Each chunk is JL_ROPE_CHUNK bytes */
+	uint32_t count;		/** How many chunks are allocated */
+	uint32_t slots;		/** How many chunk pointers "chunks" has room for */
+	uint64_t size;		/** Length of the data in bytes */
+	uint64_t curs;		/** Cursor in the data */
+}jl_rope_t;
+
+// Snapshot of live memory from jl_mem_stats().
+typedef struct{
+	m_i64_t bytes[JL_MEM_TAG_MAX];	/** Live bytes for each jl_mem_tag_t */
+	m_i64_t count[JL_MEM_TAG_MAX];	/** Live blocks for each jl_mem_tag_t */
+	m_i64_t total_bytes;		/** Live bytes for all tags */
+	m_i64_t total_count;		/** Live blocks for all tags */
+	m_u64_t shrinks;		/** Times caches were asked to shrink */
+	m_i64_t shrunk;			/** Bytes freed by shrinking caches */
+}jl_mem_stats_t;
+
+// A single-producer, single-consumer ring of packets ( see JLthread.c ).  The
+// sender's & receiver's counters are on separate cache lines.
+typedef struct{
+	// Sender's side.
+	SDL_atomic_t tail;	/** Packets sent ( wraps ) */
+	m_u32_t head_cache;	/** The sender's last look at "head" */
+	uint8_t pad0[64 - sizeof(SDL_atomic_t) - sizeof(m_u32_t)];
+	// Receiver's side.
+	SDL_atomic_t head;	/** Packets received ( wraps ) */
+	m_u32_t tail_cache;	/** The receiver's last look at "tail" */
+	SDL_atomic_t waiting;	/** Set while the receiver is asleep */
+	SDL_atomic_t woken;	/** Set by jl_thread_comm_wake() */
+	uint8_t pad1[64 - 3 * sizeof(SDL_atomic_t) - sizeof(m_u32_t)];
+	// Set once by jl_thread_comm_make().
+	m_u32_t size;		/** Size of each packet */
+	m_u32_t mask;		/** How many packets fit, - 1 ( a power of 2 ) */
+	uint8_t* data;		/** The packets */
+	SDL_sem* wake;		/** Posted to wake the receiver */
 }jl_comm_t;
 
+// Options for jl_thread_new_opt().
+typedef struct{
+	m_u64_t cpus;	/** CPUs it may run on ( bit i = CPU i ), 0 = any */
+	m_i8_t nice;	/** -20 ( most CPU time ) to 19 ( least ), 0 = default */
+}jl_thread_opt_t;
+
+// Threads kept on separate CPUs ( see jl_thread_cpus() ).
+typedef enum{
+	JL_THREAD_MAIN,		/** The main thread */
+	JL_THREAD_DRAW,		/** The graphics thread */
+	JL_THREAD_AUDIO,	/** SDL's audio thread */
+	JL_THREAD_WORKER,	/** Job workers */
+	JL_THREAD_ANY,		/** Other threads ( any CPU ) */
+}jl_thread_role_t;
+
+// Lock statistics for 1 mutex ( see jl_thread_profile_stats() ).
+typedef struct{
+	str_t name;		/** Name from jl_thread_mutex_name(), or NULL */
+	void* mutex;		/** The SDL_mutex */
+	m_u64_t count;		/** Times locked */
+	m_u64_t contended;	/** Times another thread had it locked */
+	m_u64_t wait_total;	/** Microseconds waited to lock it */
+	m_u64_t wait_max;	/** Longest wait to lock it, in microseconds */
+	m_u64_t holds[16];	/** Holds of 2^i to 2^(i+1) microseconds */
+}jl_mutex_stats_t;
+
+// Counts unfinished jobs ( see JLjob.c ).  Must start cleared to 0.
+typedef struct{
+	SDL_atomic_t count;	/** Jobs started, but not finished */
+}jl_job_counter_t;
+
 //Standard Mode Class
 typedef struct {
 	void* init;
@@ -63,21 +143,43 @@ typedef struct {
 typedef struct{
 	SDL_Thread* thread;
 	SDL_threadID thread_id;
+	uint8_t used; // Set while a thread owns this context.
 
 	struct {
 		int8_t ofs2;
-		char stack[50][30];
+		str_t stack[50]; // Names of open blocks ( not copied ).
 		uint8_t level;
 	}print;
+	// Lines queued for the print writer thread ( see JLprint.c ).
+	void* print_ring;
+
+	// Per-frame scratch memory ( see jl_mem_frame_alloc() ).
+	struct {
+		uint8_t* data;	/** The arena's memory block */
+		m_u32_t size;	/** Size of "data" in bytes */
+		m_u32_t used;	/** Bytes of "data" handed out this frame */
+		m_u32_t over;	/** Bytes that didn't fit in "data" this frame */
+		void* spill;	/** List of allocations that didn't fit */
+	}frame;
+
+	// Growable format buffers ( see jl_mem_format() and jl_print() ).
+	struct {
+		char* data;	/** The formatted string */
+		m_u32_t size;	/** Size of "data" in bytes */
+	}format, log;
+
+	// Random number generator ( see jl_mem_random_int() ).
+	struct {
+		m_u32_t s[4];		/** xoshiro128** state */
+		m_u32_t lane[4][4];	/** 4 interleaved states for bulk fills */
+	}random;
 
 	void* temp_ptr;
-	char temp[256];
 }jl_ctx_t;
 
 typedef struct{
 	struct{
 		void* printfn; // Function for printing
-		SDL_mutex* mutex; // Mutex for printing to terminal
 	}print;
 	struct{
 		m_f64_t psec; // Seconds since last frame.
@@ -90,6 +192,8 @@ typedef struct{
 		jl_mode_t mode; // Current Mode Data
 		uint16_t which;
 		uint16_t count;
+		m_u32_t resume; // Where a yielding init / loop continues ( 0=top )
+		m_u8_t initing; // Set while a yielding init hasn't finished.
 	}mode;
 	m_str_t name; // The name of the program.
 	uint32_t info; // @startup:# images loaded from media.zip.Set by others.
@@ -98,7 +202,11 @@ typedef struct{
 	//
 	m_u8_t mode_switch_skip;
 	//
-	jl_ctx_t jl_ctx[16];
+	// Thread contexts, indexed by thread ID ( see JLthread.c ).
+	jl_ctx_t** jl_ctx;
+	m_u16_t thread_count; // How many contexts "jl_ctx" has.
+	m_u16_t thread_slots; // How many pointers "jl_ctx" has room for.
+	SDL_SpinLock thread_lock; // Lock for "jl_ctx" & "thread_count".
 	// Program's context.
 	void* prg_context;
 	// Built-in library pointers.
@@ -109,5 +217,24 @@ typedef struct{
 typedef void(*jl_fnct)(jl_t* jl);
 typedef void(*jl_data_fnct)(jl_t* jl, void* data);
 typedef void(*jl_print_fnt)(jl_t* jl, const char * print);
+typedef u64_t(*jl_mem_shrink_fnt)(jl_t* jl, void* data, u64_t bytes);
+// Parallel algorithms ( see JLpar.c ).
+typedef void(*jl_par_fnt)(jl_t* jl, void* data, u32_t start, u32_t end);
+typedef void(*jl_par_map_fnt)(jl_t* jl, void* data, const void* src,
+	void* dst);
+typedef void(*jl_par_reduce_fnt)(jl_t* jl, void* data, void* acc,
+	const void* src);
+typedef int(*jl_par_cmp_fnt)(const void* a, const void* b);
+// A result that's still being made ( see JLasync.c ).
+typedef struct jl_future_s jl_future_t;
+typedef void*(*jl_async_fnt)(jl_t* jl, void* arg);
+typedef void(*jl_future_fnt)(jl_t* jl, void* result, void* data);
+
+// A binary stream over a data_t ( see JLstream.c ).
+typedef struct{
+	data_t* data;	/** The data to read & write ( not owned ) */
+	jl_t* jl;	/** The library context, for growing "data" */
+	uint8_t error;	/** Set when a read goes past the end of "data" */
+}jl_stream_t;
 
 //
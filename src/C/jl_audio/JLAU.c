@@ -11,9 +11,11 @@
 #include "JLau.h"
 
 #define JLAU_DEBUG_CHECK(jlau) jlau_checkthread__(jlau)
+// About how much SDL_mixer keeps for a loaded track ( for jlau_shrink__() ).
+#define JLAU_MUS_SIZE (128 * 1024)
 
 void jlau_checkthread__(jlau_t* jlau) {
-	uint8_t thread = jl_thread_current(jlau->jl);
+	uint16_t thread = jl_thread_current(jlau->jl);
 	if(thread != 0) {
 		jl_print(jlau->jl, "Audio fn is on the Wrong Thread: %d",
 			thread);
@@ -48,6 +50,8 @@ void jlau_load(jlau_t* jlau, u32_t IDinStack, const void *data, u32_t dataSize,
 	jlau->jmus[IDinStack]._MUS = music;
 	jl_print(jlau->jl, "Read step 3:");
 	jlau->jmus[IDinStack]._VOL = volumeChange;
+	jlau->jmus[IDinStack]._DAT = data;
+	jlau->jmus[IDinStack]._SIZ = dataSize;
 	if(jlau->jmus[IDinStack]._MUS == NULL) {
 		jl_print(jlau->jl, ":Couldn't load music because: %s",
 			(char *)SDL_GetError());
@@ -95,6 +99,13 @@ void jlau_panning_default(void) {
 
 /** @cond **/
 void _jlau_play(jlau_t* jlau) {
+	jlau_jmus_t__* mus = &jlau->jmus[jlau->idis];
+
+	// Reload music that was freed by jlau_shrink__().
+	if(mus->_MUS == NULL && mus->_DAT)
+		mus->_MUS = Mix_LoadMUS_RW(
+			SDL_RWFromConstMem(mus->_DAT, mus->_SIZ), 1);
+	jlau->iplay = jlau->idis;
 	Mix_VolumeMusic(jlau->jmus[jlau->idis]._VOL);
 	Mix_FadeInMusic(jlau->jmus[jlau->idis]._MUS, 1, jlau->sofi * 1000);
 }
@@ -190,7 +201,51 @@ void jlau_add_audio(jlau_t* jlau, str_t pzipfile, uint16_t pigid) {
 	jl_print_return(jlau->jl, "AU_Load");
 }
 
+// Make the decoders back on the main thread.
+static void jlau_add_audio_done__(jl_t* jl, void* result, void* data) {
+	jlau_t* jlau = data;
+	data_t* aud = result;
+
+	JLAU_DEBUG_CHECK(jlau);
+	if(aud != NULL) _jlau_init_sounds(jlau, aud->data);
+}
+
+/**
+ * Load all audiotracks from a zipfile without waiting.  The package is read
+ * on a job worker, then the tracks get their ID's on the main thread at the
+ * start of a later frame.
+ * @param jlau: audio library context
+ * @param pzipfile: full file name of a zip file.
+ * @param pigid: which audio group to load the soundtracks into.
+*/
+void jlau_add_audio_async(jlau_t* jlau, str_t pzipfile, uint16_t pigid) {
+	jl_future_t* future = jl_file_media_async(jlau->jl, "jlex/2/_aud",
+		pzipfile, jl_gem(), jl_gem_size());
+
+	jl_future_then(jlau->jl, future, jlau_add_audio_done__, jlau);
+}
+
 /** @cond **/
+// Memory pressure: free decoders of music that isn't playing.  SDL_mixer
+// allocates them, so jl_mem can't see them; report an estimate instead.
+static u64_t jlau_shrink__(jl_t* jl, void* data, u64_t bytes) {
+	jlau_t* jlau = data;
+	m_u64_t freed = 0;
+	m_u32_t i;
+
+	for(i = 0; i < jlau->total && freed < bytes; i++) {
+		if(i == jlau->idis || jlau->jmus[i]._MUS == NULL) continue;
+		// Freeing a playing ( or fading out ) track waits for it to stop.
+		if(i == jlau->iplay && (Mix_PlayingMusic() ||
+			Mix_FadingMusic() != MIX_NO_FADING)) continue;
+		if(jlau->jmus[i]._DAT == NULL) continue;
+		Mix_FreeMusic(jlau->jmus[i]._MUS);
+		jlau->jmus[i]._MUS = NULL;
+		freed += JLAU_MUS_SIZE;
+	}
+	return freed;
+}
+
 static inline void _jlau_print_openblock(jl_t* jl) {
 	jl_print_function(jl, "AU");
 }
@@ -200,22 +255,32 @@ static inline void _jlau_print_closeblock(jl_t* jl) {
 }
 
 jlau_t* jlau_init(jl_t* jl) {
-	jlau_t* jlau = jl_memi(jl, sizeof(jlau_t));
+	jlau_t* jlau = jl_memi__(jl, sizeof(jlau_t), JL_MEM_TAG_AU);
+	u64_t cpus = jl_thread_pinned(jl);
+	int rc;
 
 	jlau->jl = jl;
 	jl->jlau = jlau;
 	JLAU_DEBUG_CHECK(jlau);
 	//audio by default is disabled
-	jlau->jmus = jl_memi(jlau->jl, 10 * sizeof(jlau_jmus_t__));
+	jlau->jmus = jl_memi__(jlau->jl, 10 * sizeof(jlau_jmus_t__),
+		JL_MEM_TAG_AU);
 	jlau->total = 10;
 	jl_print(jlau->jl, "m %p", jlau->jmus);
+	jl_mem_shrink_add(jl, jlau_shrink__, jlau);
 
 	jlau->idis = UINT32_MAX; 
+	jlau->iplay = UINT32_MAX;
 	//Open Block AUDI
 	_jlau_print_openblock(jl);
 	// Open the audio device
 	jl_print(jl, "initializing audio....");
-	if ( Mix_OpenAudio(44100, AUDIO_S16SYS, 2, 1024) < 0 ) {
+	// SDL's audio thread starts with this thread's CPUs, so switch to the
+	// audio CPU while it's made.
+	jl_thread_pin(jl, jl_thread_cpus(jl, JL_THREAD_AUDIO));
+	rc = Mix_OpenAudio(44100, AUDIO_S16SYS, 2, 1024);
+	jl_thread_pin(jl, cpus);
+	if ( rc < 0 ) {
 		jl_print(jl,
 			":Couldn't set 11025 Hz 16-bit audio because: %s",
 			(char *)SDL_GetError());
@@ -239,12 +304,13 @@ void jlau_kill(jlau_t* jlau) {
 	_jlau_print_openblock(jlau->jl);
 	jl_print(jlau->jl, "Quiting....");
 	//Free Everything
+	jl_mem_shrink_remove(jlau->jl, jlau_shrink__, jlau);
 	Mix_CloseAudio();
 	m_u32_t i;
 	for(i = 0; i < jlau->total; i++) {
 		Mix_FreeMusic(jlau->jmus[i]._MUS);
 	}
-	free(jlau->jmus);
+	jl_mem__(jlau->jl, jlau->jmus, 0, JL_MEM_TAG_AU);
 	
 	jl_print(jlau->jl, "Quit Successfully!");
 	//Close Block AUDI
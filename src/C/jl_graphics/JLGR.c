@@ -34,7 +34,7 @@ static void jlgr_init_event(jl_t* jl, void* data) {
  * @returns The jlgr library context.
 **/
 jlgr_t* jlgr_init(jl_t* jl, u8_t fullscreen, jl_fnct fn_) {
-	jlgr_t* jlgr = jl_memi(jl, sizeof(jlgr_t));
+	jlgr_t* jlgr = jl_memi__(jl, sizeof(jlgr_t), JL_MEM_TAG_GL);
 	jlgr_thread_packet_t packet = { JLGR_COMM_INIT, 0, 0, fn_ };
 
 	jl_print_function(jl, "JL/GR/INIT");
@@ -51,18 +51,24 @@ jlgr_t* jlgr_init(jl_t* jl, u8_t fullscreen, jl_fnct fn_) {
 	// Create mutex for multi-threading
 	jlgr->mutex = jl_thread_mutex_new(jl);
 	jlgr->mutexs.usr_ctx = jl_thread_mutex_new(jl);
+	jl_thread_mutex_name(jl, jlgr->mutex, "jlgr");
+	jl_thread_mutex_name(jl, jlgr->mutexs.usr_ctx, "jlgr/usr_ctx");
 	// Create communicators for multi-threading
-	jlgr->comm2draw = jl_thread_comm_make(jl,sizeof(jlgr_thread_packet_t));
-	jlgr->comm2main = jl_thread_comm_make(jl,sizeof(jlgr_thread_packet_t));
+	jlgr->comm2draw = jl_thread_comm_make(jl, sizeof(jlgr_comm_t),
+		JLGR_COMM_COUNT);
+	jlgr->comm2main = jl_thread_comm_make(jl, sizeof(jlgr_thread_packet_t),
+		JLGR_COMM_COUNT);
 	// Start Drawing thread.
 	jlgr_thread_init(jlgr);
 	// Send graphical Init function
-	jl_thread_comm_send(jl, jlgr->comm2draw, &packet);
+	jlgr_thread_push__(jlgr, &packet, sizeof(packet));
 	// Wait for drawing thread to initialize.
 	jl_print(jl, "Main thread wait....");
 	jlgr->main.rtn = 0;
-	while(!jlgr->main.rtn)
+	while(!jlgr->main.rtn) {
+		jl_thread_comm_wait(jl, jlgr->comm2main, SDL_MUTEX_MAXWAIT);
 		jl_thread_comm_recv(jl,jlgr->comm2main,jlgr_init_event);
+	}
 	jl_print(jl, "Main thread done did wait....");
 	return jlgr;
 }
@@ -88,10 +94,33 @@ void jlgr_loop_set(jlgr_t* jlgr, jl_fnct onescreen, jl_fnct upscreen,
 		packet = (jlgr_thread_packet_t) {
 			JLGR_COMM_SEND, i, 0, redraw[i]
 		};
-		jl_thread_comm_send(jlgr->jl, jlgr->comm2draw, &packet);
+		jlgr_thread_push__(jlgr, &packet, sizeof(packet));
 	}
 }
 
+/**
+ * Choose when the draw thread redraws the screen.  By default it redraws every
+ * frame.  On-demand, it sleeps until a packet is sent to it ( ex: resize,
+ * jlgr_loop_set(), jlgr_notify() ) or jlgr_redraw() is called, so a static
+ * screen doesn't use any CPU.  Programs that animate must call jlgr_redraw()
+ * each frame they change.
+ * @param jlgr: The jlgr library context.
+ * @param ondemand: 1 to redraw on-demand, 0 to redraw every frame.
+**/
+void jlgr_draw_ondemand(jlgr_t* jlgr, u8_t ondemand) {
+	SDL_AtomicSet(&jlgr->draw.ondemand, ondemand);
+	jlgr_redraw(jlgr);
+}
+
+/**
+ * Ask the draw thread to redraw the screen.  Any thread may call this.
+ * @param jlgr: The jlgr library context.
+**/
+void jlgr_redraw(jlgr_t* jlgr) {
+	SDL_AtomicSet(&jlgr->draw.request, 1);
+	jl_thread_comm_wake(jlgr->jl, jlgr->comm2draw);
+}
+
 /**
  * Update input.
  * @param jlgr: The jlgr library context.
@@ -121,9 +150,11 @@ void jlgr_kill(jlgr_t* jlgr) {
 	jlgr_thread_packet_t packet = { JLGR_COMM_KILL, 0, 0, NULL };
 
 	jl_print(jlgr->jl, "Sending Kill to threads....");
-	jl_thread_comm_send(jlgr->jl, jlgr->comm2draw, &packet);
+	jlgr_thread_push__(jlgr, &packet, sizeof(packet));
 	jl_print(jlgr->jl, "Waiting on threads....");
 	jlgr_thread_kill(jlgr); // Shut down thread.
+	jl_thread_comm_kill(jlgr->jl, jlgr->comm2draw);
+	jl_thread_comm_kill(jlgr->jl, jlgr->comm2main);
 }
 
 // End of file.
@@ -1,7 +1,7 @@
 #include "JLGRinternal.h"
 
 static char* jlgr_file_fullname__(jlgr_t* jlgr, char* selecteddir,
-	char* selecteditem)
+	str_t selecteditem)
 {
 	jl_t* jl = jlgr->jl;
 	jvct_t * _jl = jl->_jl;
@@ -59,7 +59,7 @@ static uint8_t _jl_fl_user_select_open_dir(jlgr_t* jlgr, char *dirname) {
 			cl_list_add(_jl->fl.filelist, element);
 		}
 		closedir(dir);
-		jl_cl_list_alphabetize(_jl->fl.filelist);
+		jl_cl_list_alphabetize(jlgr->jl, _jl->fl.filelist);
 	} else {
 		//Couldn't open Directory
 		int errsv = errno;
@@ -109,7 +109,10 @@ uint8_t jlgr_openfile_init(jlgr_t* jlgr, str_t program_name, void *newfiledata,
 	_jl->fl.newfiledata = newfiledata;
 	_jl->fl.newfilesize = newfilesize;
 	_jl->fl.prompt = 0;
-	_jl->fl.promptstring = NULL;
+	if(_jl->fl.promptstring) {
+		jl_text_free(jlgr->jl, _jl->fl.promptstring);
+		_jl->fl.promptstring = NULL;
+	}
 	if(program_name[0] == '!') {
 		char *path = jl_mem_copy(jlgr->jl,program_name,
 			strlen(program_name));
@@ -255,7 +258,8 @@ void jlgr_openfile_loop(jlgr_t* jlgr) {
 		{
 			char *name = jlgr_file_fullname__(jlgr,
 				_jl->fl.dirname,
-				(char*)_jl->fl.promptstring->data);
+				jl_text_string(jlgr->jl,
+					_jl->fl.promptstring));
 			name[strlen(name) - 1] = '\0';
 			jl_file_save(jlgr->jl, _jl->fl.newfiledata,
 				name, _jl->fl.newfilesize);
@@ -39,15 +39,38 @@ typedef struct{
 	}
 
 	static void _jlgr_textbox_lt(jlgr_t* jlgr, jlgr_input_t input) {
+		jl_text_t* text = jlgr->gr.textbox_string;
+
 		jl_ct_typing_disable();
-		if(jlgr->gr.textbox_string->curs)
-			jlgr->gr.textbox_string->curs--;
+		if(jl_text_cursor(text))
+			jl_text_seek(text, jl_text_cursor(text) - 1);
 	}
 
 	static void _jlgr_textbox_rt(jlgr_t* jlgr, jlgr_input_t input) {
+		jl_text_t* text = jlgr->gr.textbox_string;
+
 		jl_ct_typing_disable();
-		if(jlgr->gr.textbox_string->curs < jlgr->gr.textbox_string->size)
-			jlgr->gr.textbox_string->curs++;
+		jl_text_seek(text, jl_text_cursor(text) + 1);
+	}
+
+	// Draw "len" characters of "str", moving "tr" past them.
+	static void _jlgr_draw_text(jlgr_t* jlgr, const uint8_t* str,
+		u32_t len, jl_rect_t rc, jl_vec3_t* tr, jl_font_t f)
+	{
+		jl_vo_t* vo = jlgr->gl.temp_vo;
+		uint32_t i;
+
+		for(i = 0; i < len; i++) {
+			//Font 0:0
+			jlgr_vos_image(jlgr,vo,rc,0,JL_IMGI_FONT,str[i],255);
+			jl_gl_transform_chr_(jlgr, vo, tr->x, tr->y, tr->z,
+				1., 1., 1.);
+			jl_gl_draw_chr(jlgr, vo,((double)f.colors[0])/255.,
+				((double)f.colors[1])/255.,
+				((double)f.colors[2])/255.,
+				((double)f.colors[3])/255.);
+			tr->x += f.size;
+		}
 	}
 
 /**      @endcond      **/
@@ -146,7 +169,7 @@ typedef struct{
 	 * @param rgba: The color to convert ( Not freed - Reusable ).
 	 * @param vc: How many vertices to acount for.
 	 * @param gradient: 1 if "rgba" is a gradient array, 0 if solid color.
-	 * @returns: The converted color
+	 * @returns: The converted color, valid until the end of this frame.
 	**/
 	jl_ccolor_t* jlgr_convert_color(jlgr_t* jlgr, uint8_t *rgba, uint32_t vc,
 		uint8_t gradient)
@@ -160,7 +183,7 @@ typedef struct{
  	 * @param jl: The library context.
  	 * @param pv: The Vertex Object
  	 * @param cc: The Converted Color Object to use on the Vertex Object.
- 	 *	The library takes care of freeing this variable.
+ 	 *	Comes from jlgr_convert_color() this frame - don't free it.
 	**/
 	void jlgr_vo_color(jlgr_t* jlgr, jl_vo_t* pv, jl_ccolor_t* cc) {
 		jl_gl_clrc(jlgr, pv, cc);
@@ -308,25 +331,34 @@ typedef struct{
 	void jlgr_draw_text(jlgr_t* jlgr, str_t str, jl_vec3_t loc,
 		jl_font_t f)
 	{
-		const void *Str = str;
-		const uint8_t *STr = Str;
-		uint32_t i;
 		jl_rect_t rc = { loc.x, loc.y, f.size, f.size };
 		jl_vec3_t tr = { 0., 0., 0. };
-		jl_vo_t* vo = jlgr->gl.temp_vo;
 
 		if(str == NULL) return;
-		for(i = 0; i < strlen(str); i++) {
-			//Font 0:0
-			jlgr_vos_image(jlgr,vo,rc,0,JL_IMGI_FONT,STr[i],255);
-			jl_gl_transform_chr_(jlgr, vo, tr.x, tr.y, tr.z,
-				1., 1., 1.);
-			jl_gl_draw_chr(jlgr, vo,((double)f.colors[0])/255.,
-				((double)f.colors[1])/255.,
-				((double)f.colors[2])/255.,
-				((double)f.colors[3])/255.);
-			tr.x += f.size;
-		}
+		_jlgr_draw_text(jlgr, (const uint8_t*)str, strlen(str), rc, &tr,
+			f);
+	}
+
+	/**
+	 * Draw editable text on the current pre-renderer, straight from it's
+	 * buffer ( without making a flat copy ).
+	 * @param 'jl': library context
+	 * @param 'text': the text to draw
+	 * @param 'loc': the position to draw it at
+	 * @param 'f': the font to use.
+	**/
+	void jlgr_draw_text_gap(jlgr_t* jlgr, const jl_text_t* text,
+		jl_vec3_t loc, jl_font_t f)
+	{
+		jl_rect_t rc = { loc.x, loc.y, f.size, f.size };
+		jl_vec3_t tr = { 0., 0., 0. };
+		m_u32_t len;
+		str_t part;
+
+		part = jl_text_part(text, 0, &len);
+		_jlgr_draw_text(jlgr, (const uint8_t*)part, len, rc, &tr, f);
+		part = jl_text_part(text, 1, &len);
+		_jlgr_draw_text(jlgr, (const uint8_t*)part, len, rc, &tr, f);
 	}
 
 	/**
@@ -375,6 +407,22 @@ typedef struct{
 				fontsize});
 	}
 
+	/**
+	 * Draw editable text within the boundary of a sprite
+	 * @param 'jl': library context
+	 * @param 'spr': the boundary sprite
+	 * @param 'text': the text to draw
+	**/
+	void jlgr_draw_text_area_gap(jlgr_t* jlgr, jl_sprite_t * spr,
+		const jl_text_t* text)
+	{
+		float fontsize = .9 / jl_text_length(text);
+		jlgr_draw_text_gap(jlgr, text,
+			(jl_vec3_t) { .05,.5 * (jl_gl_ar(jlgr) - fontsize),0. },
+			(jl_font_t) { 0, JL_IMGI_ICON, 0, jlgr->fontcolor, 
+				fontsize});
+	}
+
 	/**
 	 * Draw a sprite, then draw text within the boundary of a sprite
  	 * @param 'jl': library context
@@ -647,6 +695,7 @@ typedef struct{
 			jlgr_input_do(jlgr, JL_CT_PRESS, prun);
 			spr->cb.x = defaultx + slidex;
 		}
+		jlgr_sprite_publish(jlgr, spr);
 		jlgr_sprite_draw(jlgr, spr);
 	}
 
@@ -684,35 +733,35 @@ typedef struct{
 
 	/**
 	 * Draw A Textbox.
+	 * @param string: The text to edit, made if NULL ( free it with
+	 *	jl_text_free() ).
 	 * @return 1 if return/enter is pressed.
 	 * @return 0 if not.
 	*/
 	uint8_t jlgr_draw_textbox(jlgr_t* jlgr, float x, float y, float w,
-		float h, data_t* *string)
+		float h, jl_text_t* *string)
 	{
 		uint8_t bytetoinsert = 0;
 
-		if(*string == NULL) *string = jl_data_make(1);
+		if(*string == NULL) *string = jl_text_make(jlgr->jl, NULL);
 		jlgr->gr.textbox_string = *string;
 		if((bytetoinsert = jl_ct_typing_get(jlgr))) {
 			if(bytetoinsert == '\b') {
-				if((*string)->curs == 0) return 0;
-				(*string)->curs--;
-				jl_data_delete_byte(jlgr->jl, *string);
+				if(jl_text_cursor(*string) == 0) return 0;
+				jl_text_backspace(*string);
 			}else if(bytetoinsert == '\02') {
-				jl_data_delete_byte(jlgr->jl, *string);
+				jl_text_delete(*string);
 			}else if(bytetoinsert == '\n') {
 				return 1;
 			}else{
-				jl_data_insert_byte(jlgr->jl, *string,
-					 bytetoinsert);
+				jl_text_insert(jlgr->jl, *string, bytetoinsert);
 			}
 //			JL_PRINT("inserting %1s\n", &bytetoinsert);
 		}
 		jlgr_input_do(jlgr, JL_CT_MAINLT, _jlgr_textbox_lt);
 		jlgr_input_do(jlgr, JL_CT_MAINRT, _jlgr_textbox_rt);
 //		jlgr_draw_image(jl, 0, 0, x, y, w, h, ' ', 255);
-		jlgr_draw_text(jlgr, (char*)((*string)->data),
+		jlgr_draw_text_gap(jlgr, *string,
 			(jl_vec3_t) {x, y, 0.},
 			(jl_font_t) {0,JL_IMGI_ICON,0,jlgr->fontcolor,h});
 //		jlgr_draw_image(jl, 0, 0,
@@ -728,11 +777,15 @@ typedef struct{
 	*/
 	void jlgr_notify(jlgr_t* jlgr, str_t notification) {
 		jlgr_comm_notify_t packet;
+		m_u32_t len = strlen(notification);
+
 		packet.id = JLGR_COMM_NOTIFY;
-		jl_mem_copyto(notification, packet.string, 256);
-		packet.string[strlen(notification)] = '\0';
+		// Packets are fixed-size, so clip long notifications.
+		if(len > 255) len = 255;
+		jl_mem_copyto(notification, packet.string, len);
+		packet.string[len] = '\0';
 
-		jl_thread_comm_send(jlgr->jl, jlgr->comm2draw, &packet);
+		jlgr_thread_push__(jlgr, &packet, sizeof(packet));
 	}
 
 /***      @cond       ***/
@@ -820,5 +873,5 @@ data_t* jl_vi_make_jpeg(jl_t* jl,i32_t quality,m_u8_t* pxdata,u16_t w,u16_t h) {
 }
 
 m_u8_t* jlgr_load_image(jl_t* jl, data_t* data, m_u16_t* w, m_u16_t* h) {
-	return jl_vi_load_(jl, data, w, h);
+	return jl_vi_load_(jl, jl_data_view(data), w, h);
 }
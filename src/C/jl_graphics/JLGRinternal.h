@@ -39,8 +39,18 @@ typedef struct{
 	char string[256];
 }jlgr_comm_notify_t;
 
+// Room for any packet sent between the main & draw threads.
+typedef union{
+	jlgr_thread_packet_t packet;
+	jlgr_comm_notify_t notify;
+}jlgr_comm_t;
+
+#define JLGR_COMM_COUNT 64 // Packets that can be queued for the other thread.
+#define JLGR_FRAME_MS (1000 / JL_FPS) // Time between frames when not on-demand.
+
 void jl_sg_add_some_imgs_(jlgr_t* jlgr, u16_t x);
 uint32_t _jl_sg_gpix(/*in */ SDL_Surface* surface, int32_t x, int32_t y);
+void jl_sg_pixels__(jl_t* jl, SDL_Surface* image, m_u8_t* pixels, u8_t rgba);
 void jl_gl_viewport_screen(jlgr_t* jlgr);
 void jl_gl_poly(jlgr_t* jlgr, jl_vo_t* pv, uint8_t vertices, const float *xyzw);
 void jl_gl_vect(jlgr_t* jlgr, jl_vo_t* pv, uint8_t vertices, const float *xyzw);
@@ -71,7 +81,7 @@ void _jl_dl_loop(jvct_t* _jlc);
 void _jl_sg_loop(jlgr_t* jlgr);
 float jl_sg_seconds_past_(jl_t* jlc);
 data_t* jl_vi_make_jpeg_(jl_t* jlc,i32_t quality,m_u8_t* pxdata,u16_t w,u16_t h);
-m_u8_t* jl_vi_load_(jl_t* jlc, data_t* data, m_u16_t* w, m_u16_t* h);
+m_u8_t* jl_vi_load_(jl_t* jlc, jl_view_t data, m_u16_t* w, m_u16_t* h);
 
 // Resize function
 void jl_dl_resz__(jlgr_t* jlgr, uint16_t x, uint16_t y);
@@ -97,6 +107,7 @@ void jl_dl_kill__(jlgr_t* jlgr);
 void jlgr_thread_kill(jlgr_t* jlgr);
 //
 void jlgr_thread_send(jlgr_t* jlgr, u8_t id, u16_t x, u16_t y, jl_fnct fn);
+void jlgr_thread_push__(jlgr_t* jlgr, const void* packet, u32_t size);
 
 //
 void jl_wm_updatewh_(jlgr_t* jlgr);
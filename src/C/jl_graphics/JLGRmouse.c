@@ -61,7 +61,7 @@ void jlgr_mouse_init__(jlgr_t* jlgr) {
 		((jl_sprite_t*)jlgr->mouse)->ctx = NULL;
 	#endif
 	mouse = jlgr->mouse;
-	jlgr_sprite_resize(jlgr, mouse, NULL);
+	jlgr_sprite_resize(jlgr, mouse);
 	// Set the mouse's collision width and height to 0
 	mouse->cb.w = 0.f;
 	mouse->cb.h = 0.f;
@@ -123,11 +123,11 @@ void jl_gl_pr_scr(jlgr_t* jlgr);
 
 #ifdef JL_DEBUG_LIB
 	static void jl_gl_get_error___(jlgr_t* jlgr, int width, str_t fname) {
-		uint8_t thread = jl_thread_current(jlgr->jl);
-		if(thread != 1) {
+		uint16_t thread = jl_thread_current(jlgr->jl);
+		if(thread != jlgr->thread) {
 			jl_print(jlgr->jl, "\"%s\" is on the Wrong Thread: %d",
 				fname, thread);
-			jl_print(jlgr->jl, "Must be on thread 1!");
+			jl_print(jlgr->jl, "Must be on thread %d!", jlgr->thread);
 			jl_print_stacktrace(jlgr->jl);
 			exit(-1);
 		}
@@ -386,11 +386,11 @@ void jl_gl_maketexture(jlgr_t* jlgr, uint16_t gid, uint16_t id,
 	}
 	if (jlgr->gl.allocatedg < gid + 1) {
 		jlgr->gl.textures =
-			realloc(jlgr->gl.textures,
-				sizeof(uint32_t *) * (gid+1));
+			jl_mem__(jlgr->jl, jlgr->gl.textures,
+				sizeof(uint32_t *) * (gid+1), JL_MEM_TAG_GL);
 		jlgr->gl.tex.uniforms.textures =
-			realloc(jlgr->gl.tex.uniforms.textures,
-				sizeof(GLint *) * (gid+1));
+			jl_mem__(jlgr->jl, jlgr->gl.tex.uniforms.textures,
+				sizeof(GLint *) * (gid+1), JL_MEM_TAG_GL);
 		jlgr->gl.allocatedg = gid + 1;
 		jlgr->gl.allocatedi = 0;
 		jlgr->gl.textures[gid] = NULL;
@@ -398,11 +398,11 @@ void jl_gl_maketexture(jlgr_t* jlgr, uint16_t gid, uint16_t id,
 	}
 	if (jlgr->gl.allocatedi < id + 1) {
 		jlgr->gl.textures[gid] =
-			realloc(jlgr->gl.textures[gid],
-				sizeof(uint32_t) * (id+1));
+			jl_mem__(jlgr->jl, jlgr->gl.textures[gid],
+				sizeof(uint32_t) * (id+1), JL_MEM_TAG_GL);
 		jlgr->gl.tex.uniforms.textures[gid] =
-			realloc(jlgr->gl.tex.uniforms.textures[gid],
-				sizeof(GLint) * (id+1));
+			jl_mem__(jlgr->jl, jlgr->gl.tex.uniforms.textures[gid],
+				sizeof(GLint) * (id+1), JL_MEM_TAG_GL);
 		jlgr->gl.allocatedi = id + 1;
 	}
 	JL_PRINT_DEBUG(jlgr->jl, "generating texture (%d,%d)",width,height);
@@ -483,30 +483,20 @@ static inline void _jl_gl_init_enable_alpha(jlgr_t* jlgr) {
 	JL_GL_ERROR(jlgr, 0,"glBlendFunc");
 }
 
-// Copy & Push vertices to a VBO.
+// Push vertices to a VBO.
 static void jl_gl_vertices__(jlgr_t* jlgr, const float *xyzw, uint8_t vertices,
-	float* cv, u32_t gl)
+	u32_t gl)
 {
-	u16_t items = (vertices*3);
-
-	// Copy Vertices
-	jl_mem_copyto(xyzw, cv, items * sizeof(float));
-	// Copy Buffer Data "cv" to Buffer "gl"
-	jl_gl_buffer_set__(jlgr, gl, cv, items);
+	// Copy Buffer Data "xyzw" to Buffer "gl"
+	jl_gl_buffer_set__(jlgr, gl, xyzw, vertices * 3);
 }
 
 void jl_gl_vo_vertices(jlgr_t* jlgr, jl_vo_t* pv, const float *xyzw,
 	uint8_t vertices)
 {
 	pv->vc = vertices;
-	if(vertices) {
-		// Free pv->cv if non-null
-		if(pv->cv) pv->cv = jl_mem(jlgr->jl, pv->cv, 0);
-		// Allocate pv->cv
-		pv->cv = jl_memi(jlgr->jl, vertices * sizeof(float) * 3);
-		// Set pv->cv & pv->gl
-		jl_gl_vertices__(jlgr, xyzw, vertices, pv->cv, pv->gl);
-	}
+	// Set pv->gl
+	if(vertices) jl_gl_vertices__(jlgr, xyzw, vertices, pv->gl);
 }
 
 void jl_gl_vo_free(jlgr_t* jlgr, jl_vo_t *pv) {
@@ -514,11 +504,8 @@ void jl_gl_vo_free(jlgr_t* jlgr, jl_vo_t *pv) {
 	jl_gl_buffer_old__(jlgr, &pv->gl);
 	// Free GL Texture Buffer
 	jl_gl_buffer_old__(jlgr, &pv->bt);
-	// Free Converted Vertices & Colors
-	if(pv->cv) pv->cv = jl_mem(jlgr->jl, pv->cv, 0);
-	if(pv->cc) pv->cc = jl_mem(jlgr->jl, pv->cc, 0);
 	// Free main structure
-	pv = jl_mem(jlgr->jl, (void**)&pv, 0);
+	jl_mem__(jlgr->jl, pv, 0, JL_MEM_TAG_GL);
 }
 
 static void _jl_gl_setp(jlgr_t* jlgr, jl_gl_slpr id) {
@@ -528,11 +515,6 @@ static void _jl_gl_setp(jlgr_t* jlgr, jl_gl_slpr id) {
 	}
 }
 
-static void _jl_gl_col_begin(jlgr_t* jlgr, jl_vo_t* pv) {
-	//Free anything old
-	if(pv->cc != NULL) pv->cc = jl_mem(jlgr->jl, pv->cc, 0);
-}
-
 // TODO: MOVE
 void jl_gl_pbo_new(jlgr_t* jlgr, jl_tex_t* texture, u8_t* pixels,
 	u16_t w, u16_t h, u8_t bpp)
@@ -790,12 +772,11 @@ static void _jl_gl_txtr(jlgr_t* jlgr, jl_vo_t** pv, uint8_t a, uint8_t is_rt) {
 	// Set Simple Variabes
 	(*pv)->a = ((float)a) / 255.f;
 	// Make sure non-textured colors aren't attempted
-	if((!is_rt) && ((*pv)->cc != NULL))
-		(*pv)->cc = jl_mem(jlgr->jl, (*pv)->cc, 0);
+	if(!is_rt) (*pv)->cc = 0;
 }
 
 static inline void _jl_gl_set_shader(jlgr_t* jlgr, jl_vo_t* pv) {
-	_jl_gl_setp(jlgr, pv->cc == NULL ? JL_GL_SLPR_TEX : JL_GL_SLPR_CLR);
+	_jl_gl_setp(jlgr, pv->cc ? JL_GL_SLPR_CLR : JL_GL_SLPR_TEX);
 }
 
 // Prepare to draw a solid color
@@ -845,7 +826,7 @@ void jl_gl_pr_old_(jlgr_t* jlgr, jl_pr_t* pr) {
 	// 
 	_jl_gl_pr_obj_free(jlgr, pr);
 	// Free old pr object.
-	pr = jl_mem(jlgr->jl, pr, 0);
+	pr = jl_mem__(jlgr->jl, pr, 0, JL_MEM_TAG_GL);
 }
 
 // Free a pr for a vertex object
@@ -952,19 +933,18 @@ void jl_gl_vect(jlgr_t* jlgr, jl_vo_t* pv, uint8_t vertices, const float *xyzw)
 	jl_gl_vo_vertices(jlgr, pv, xyzw, vertices);
 }
 
-// Set colors to "cc" in vertex oject "pv" - cc will be freed when done
+// Set colors to "cc" in vertex oject "pv" - cc only needs to last this frame
 void jl_gl_clrc(jlgr_t* jlgr, jl_vo_t* pv, jl_ccolor_t* cc) {
-	_jl_gl_col_begin(jlgr, pv); // Free "pv->cc" if non-null
-	pv->cc = cc;
-	// Set Color Buffer "pv->bt" to "pv->cc"
-	jl_gl_buffer_set__(jlgr, pv->bt, pv->cc, pv->vc * 4);
+	pv->cc = 1;
+	// Set Color Buffer "pv->bt" to "cc"
+	jl_gl_buffer_set__(jlgr, pv->bt, cc, pv->vc * 4);
 }
 
 //Convert color to solid
 jl_ccolor_t* jl_gl_clrcs(jlgr_t* jlgr, u8_t *rgba, uint32_t vc) {
 	int i;
-	//Allocate memory
-	jl_ccolor_t* cc = jl_memi(jlgr->jl, vc * sizeof(float) * 4);
+	//Allocate memory for this frame
+	jl_ccolor_t* cc = jl_mem_frame_alloc(jlgr->jl, vc * sizeof(float) * 4);
 
 	//Set RGBA for each vertex
 	for(i = 0; i < vc; i++) { 
@@ -979,8 +959,8 @@ jl_ccolor_t* jl_gl_clrcs(jlgr_t* jlgr, u8_t *rgba, uint32_t vc) {
 //Convert Color To Gradient
 jl_ccolor_t* jl_gl_clrcg(jlgr_t* jlgr, u8_t *rgba, uint32_t vc) {
 	int i;
-	//Allocate memory
-	jl_ccolor_t* cc = jl_memi(jlgr->jl, vc * sizeof(float) * 4);
+	//Allocate memory for this frame
+	jl_ccolor_t* cc = jl_mem_frame_alloc(jlgr->jl, vc * sizeof(float) * 4);
 
 	//Set RGBA for each vertex
 	for(i = 0; i < vc; i++) { 
@@ -995,14 +975,12 @@ jl_ccolor_t* jl_gl_clrcg(jlgr_t* jlgr, u8_t *rgba, uint32_t vc) {
 // Set Texturing to Gradient Color "rgba" { (4 * vertex count) values }
 void jl_gl_clrg(jlgr_t* jlgr, jl_vo_t* pv, u8_t *rgba) {
 	if(pv == NULL) pv = jlgr->gl.temp_vo;
-	_jl_gl_col_begin(jlgr, pv);
 	jl_gl_clrc(jlgr, pv, jl_gl_clrcg(jlgr, rgba, pv->vc));
 }
 
 // Set Texturing to Solid Color "rgba" { 4 values }
 void jl_gl_clrs(jlgr_t* jlgr, jl_vo_t* pv, u8_t *rgba) {
 	if(pv == NULL) pv = jlgr->gl.temp_vo;
-	_jl_gl_col_begin(jlgr, pv);
 	jl_gl_clrc(jlgr, pv, jl_gl_clrcs(jlgr, rgba, pv->vc));
 }
 
@@ -1070,13 +1048,13 @@ void jl_gl_transform_vo_(jlgr_t* jlgr, jl_vo_t* vo, float x, float y, float z,
 	f64_t ar = jl_gl_ar(jlgr);
 	if(vo == NULL) vo = jlgr->gl.temp_vo;
 
-	jl_gl_translate__(jlgr, (vo->cc == NULL) ?
+	jl_gl_translate__(jlgr, (!vo->cc) ?
 		jlgr->gl.tex.uniforms.translate:jlgr->gl.clr.uniforms.translate,
-		(vo->cc == NULL) ? JL_GL_SLPR_TEX : JL_GL_SLPR_CLR,
+		(!vo->cc) ? JL_GL_SLPR_TEX : JL_GL_SLPR_CLR,
 		x, y, z, ar);
-	jl_gl_transform__(jlgr, (vo->cc == NULL) ?
+	jl_gl_transform__(jlgr, (!vo->cc) ?
 		jlgr->gl.tex.uniforms.transform:jlgr->gl.clr.uniforms.transform,
-		(vo->cc == NULL) ? JL_GL_SLPR_TEX : JL_GL_SLPR_CLR,
+		(!vo->cc) ? JL_GL_SLPR_TEX : JL_GL_SLPR_CLR,
 		xm, ym, zm, ar);
 	// If it has a pre-renderer; transform it with.
 	if(vo->pr) jl_gl_transform_pr_(jlgr, vo->pr, x, y, z, xm, ym, zm);
@@ -1299,12 +1277,10 @@ static inline void _jl_gl_vo_make(jlgr_t* jlgr, jl_vo_t* vo, u32_t nc) {
 	jl_gl_buffer_new__(jlgr, &vo->gl);
 	// GL Texture Coordinate Buffer
 	jl_gl_buffer_new__(jlgr, &vo->bt);
-	// Converted Vertices
-	vo->cv = NULL;
 	// Vertex Count
 	vo->vc = 0;
-	// Converted Colors
-	vo->cc = NULL;
+	// Not Colored
+	vo->cc = 0;
 	// Rendering Style = Polygon
 	vo->rs = 0;
 	// Texture
@@ -1343,7 +1319,8 @@ static void jl_gl_pr_set__(jl_pr_t *pr,f32_t w,f32_t h,u16_t w_px) {
 **/
 jl_vo_t *jl_gl_vo_make(jlgr_t* jlgr, u32_t count) {
 	// Allocate space for "rtn"
-	jl_vo_t *rtn = jl_memi(jlgr->jl, sizeof(jl_vo_t) * count);
+	jl_vo_t *rtn = jl_memi__(jlgr->jl, sizeof(jl_vo_t) * count,
+		JL_MEM_TAG_GL);
 	m_u32_t i;
 
 	// Make each vertex object.
@@ -1425,7 +1402,7 @@ void jl_gl_pr_rsz(jlgr_t* jlgr, jl_pr_t *pr, f32_t w, f32_t h, u16_t w_px) {
 	// Use the screen's pre-renderer if it exists.
 	jl_gl_pr_scr(jlgr);
 	// Create the VBO.
-	jl_gl_vertices__(jlgr, xyzw, 4, pr->cv, pr->gl);
+	jl_gl_vertices__(jlgr, xyzw, 4, pr->gl);
 	// Set width, height and aspect ratio.
 	jl_gl_pr_set__(pr, w, h, w_px);
 	// Resize the actual texture.
@@ -1442,7 +1419,7 @@ void jl_gl_pr_rsz(jlgr_t* jlgr, jl_pr_t *pr, f32_t w, f32_t h, u16_t w_px) {
 **/
 jl_pr_t * jl_gl_pr_new(jlgr_t* jlgr, f32_t w, f32_t h, u16_t w_px) {
 	// Make the pr structure.
-	jl_pr_t *pr = jl_memi(jlgr->jl, sizeof(jl_pr_t));
+	jl_pr_t *pr = jl_memi__(jlgr->jl, sizeof(jl_pr_t), JL_MEM_TAG_GL);
 
 	jl_print_function(jlgr->jl, "GL_PR_NEW");
 	// Set the initial pr structure values - Nothings made yet.
@@ -1450,8 +1427,6 @@ jl_pr_t * jl_gl_pr_new(jlgr_t* jlgr, f32_t w, f32_t h, u16_t w_px) {
 	pr->db = 0;
 	pr->fb = 0;
 	pr->gl = 0;
-	// Allocate pr->cv 
-	pr->cv = jl_memi(jlgr->jl, 4*sizeof(float)*3);
 	// Set width, height and aspect ratio.
 	jl_gl_pr_set__(pr, w, h, w_px);
 	// Make OpenGL Objects
@@ -51,6 +51,43 @@ uint32_t _jl_sg_gpix(/*in */ SDL_Surface* surface, int32_t x, int32_t y) {
 	return color;
 }
 
+// Rows of a surface being converted by jl_sg_pixels__().
+typedef struct{
+	SDL_Surface* image;
+	m_u8_t* pixels;
+	m_u8_t rgba;
+}jl_sg_pixels_t;
+
+static void jl_sg_pixels_rows__(jl_t* jl, void* data, u32_t start, u32_t end) {
+	jl_sg_pixels_t* conv = data;
+	m_u8_t* out = conv->pixels + start * conv->image->w * conv->rgba;
+	uint32_t color;
+	m_i32_t i, j;
+
+	for(i = start; i < end; i++) {
+		for(j = 0; j < conv->image->w; j++) {
+			color = _jl_sg_gpix(conv->image, j, i);
+			jl_mem_copyto(&color, out, conv->rgba);
+			out += conv->rgba;
+		}
+	}
+}
+
+/**
+ * Convert a surface to packed RGBA or RGB, a group of rows on each job worker.
+ * @param jl: The library context.
+ * @param image: The surface to convert.
+ * @param pixels: Where to write image->w * image->h * "rgba" bytes.
+ * @param rgba: Bytes for each pixel ( 4 = RGBA, 3 = RGB ).
+**/
+void jl_sg_pixels__(jl_t* jl, SDL_Surface* image, m_u8_t* pixels, u8_t rgba) {
+	jl_sg_pixels_t conv = { image, pixels, rgba };
+
+	// Each group of rows is at least JL_PAR_SERIAL pixels.
+	jl_par_for(jl, image->h, JL_PAR_SERIAL / image->w + 1,
+		jl_sg_pixels_rows__, &conv);
+}
+
 void _jl_sg_load_jlpx(jlgr_t* jlgr,data_t* data,void **pixels,int *w,int *h) {
 	if(data == NULL) {
 		jl_print(jlgr->jl, "NULL DATA!");
@@ -62,9 +99,8 @@ void _jl_sg_load_jlpx(jlgr_t* jlgr,data_t* data,void **pixels,int *w,int *h) {
 	jl_print_function(jlgr->jl, "SG_Jlpx"); // {
 	
 	//Check If File Is Of Correct Format
-	char *testing = malloc(strlen(JL_IMG_HEADER)+1);
-	int32_t i, j;
-
+	char *testing = jl_mem__(jlgr->jl, NULL, strlen(JL_IMG_HEADER)+1,
+		JL_MEM_TAG_SG);
 	jl_mem_copyto(data->data + jlgr->sg.init_image_location, testing,
 		strlen(JL_IMG_HEADER));
 	testing[strlen(JL_IMG_HEADER)] = '\0';
@@ -80,38 +116,38 @@ void _jl_sg_load_jlpx(jlgr_t* jlgr,data_t* data,void **pixels,int *w,int *h) {
 			jlgr->sg.image_id);
 		jl_sg_kill(jlgr->jl);
 	}
+	jl_mem__(jlgr->jl, testing, 0, JL_MEM_TAG_SG);
 	uint8_t tester = data->data[jlgr->sg.init_image_location+strlen(JL_IMG_HEADER)];
 	uint32_t FSIZE;
 	if(tester == JL_IMG_FORMAT_FLS) {
 		SDL_Surface *image;
 		SDL_RWops *rw;
-		void* img_file = NULL;
-		uint32_t color = 0;
-		data_t* pixel_data;
+		m_u8_t* pixel_data;
 
 		JL_PRINT_DEBUG(jlgr->jl, "png/gif/jpeg etc.");
 		data->curs = jlgr->sg.init_image_location+strlen(JL_IMG_HEADER)+1;
 		jl_data_loadto(data, 4, &FSIZE);
 		JL_PRINT_DEBUG(jlgr->jl, "File Size = %d", FSIZE);
-		img_file = jl_memi(jlgr->jl, FSIZE);
-		jl_data_loadto(data, FSIZE, img_file);
-		rw = SDL_RWFromMem(img_file, FSIZE);
+		if(FSIZE > data->size - data->curs) {
+			jl_print(jlgr->jl, "image #%d is cut off!",
+				jlgr->sg.image_id);
+			jl_sg_kill(jlgr->jl);
+		}
+		// Decode straight from the package ( no copy ).
+		rw = SDL_RWFromConstMem(data->data + data->curs, FSIZE);
 		if ((image = IMG_Load_RW(rw, 1)) == NULL) {
 			jl_print(jlgr->jl, "Couldn't load image: %s",
 				IMG_GetError());
 			jl_sg_kill(jlgr->jl);
 		}
-		// Covert SDL_Surface.
-		pixel_data = jl_data_make(image->w * image->h * 4);
-		for(i = 0; i < image->h; i++) {
-			for(j = 0; j < image->w; j++) {
-				color = _jl_sg_gpix(image, j, i);
-				jl_data_saveto(pixel_data, 4, &color);
-			}
-		}
+		// Covert SDL_Surface ( free'd after upload in
+		// _jl_sg_load_next_img() ).
+		pixel_data = jl_mem_large__(jlgr->jl, image->w * image->h * 4,
+			JL_MEM_TAG_SG);
+		jl_sg_pixels__(jlgr->jl, image, pixel_data, 4);
 		jlgr->sg.init_image_location += FSIZE + 6;
 		//Set Return values
-		*pixels = jl_data_tostring(jlgr->jl, pixel_data);
+		*pixels = pixel_data;
 		*w = image->w;
 		*h = image->h;
 		// Clean-up
@@ -128,9 +164,16 @@ static inline uint8_t _jl_sg_load_next_img(jlgr_t* jlgr) {
 	void *fpixels = NULL;
 	int fw;
 	int fh;
+	// Package was already fully loaded & freed.
+	if(jlgr->sg.image_data == NULL) return 0;
 	jl_print_function(jlgr->jl, "SG_Imgs");
 	_jl_sg_load_jlpx(jlgr, jlgr->sg.image_data, &fpixels, &fw, &fh);
 	if(fpixels == NULL) {
+		// Done with the package, so don't keep it in memory.
+		if(jlgr->sg.image_data) {
+			jl_data_free(jlgr->sg.image_data);
+			jlgr->sg.image_data = NULL;
+		}
 		JL_PRINT_DEBUG(jlgr->jl, "loaded %d", jlgr->sg.image_id);
 		jlgr->jl->info = jlgr->sg.image_id;
 		jl_print(jlgr->jl, "IL");
@@ -140,6 +183,7 @@ static inline uint8_t _jl_sg_load_next_img(jlgr_t* jlgr) {
 		JL_PRINT_DEBUG(jlgr->jl, "creating image #%d....", jlgr->sg.igid);
 		jl_gl_maketexture(jlgr, jlgr->sg.igid,
 			jlgr->sg.image_id, fpixels, fw, fh, 0);
+		jl_mem_large_free(jlgr->jl, fpixels);
 		JL_PRINT_DEBUG(jlgr->jl, "created image #%d:%d!", jlgr->sg.igid,
 			jlgr->sg.image_id);
 //		#endif
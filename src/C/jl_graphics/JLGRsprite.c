@@ -4,10 +4,26 @@
 */
 /** \file
  * JLGRsprite.c
- *	Handles the sprites.
+ *	Handles the sprites.  The main thread owns a sprite's "cb", "rh" &
+ *	"rw", and publishes a copy for the draw thread through a seqlock, so
+ *	neither thread locks to use a sprite.
  */
 #include "JLGRinternal.h"
 
+// How many sprite accesses didn't lock, & how many reads had to retry.  Both
+// threads ask for redraws & read states, so the counters are atomic; "main" &
+// "draw" are on separate cache lines so each thread mostly stays on it's own.
+static struct {
+	m_u64_t main;		// Loops & redraw requests.
+	uint8_t pad[JL_MEM_ALIGN];
+	m_u64_t draw;		// Draw thread's accesses.
+	m_u64_t retries;	// Reads that raced a publish.
+}jlgr_sprite_stats__;
+
+static inline void jlgr_sprite_count__(m_u64_t* counter) {
+	__atomic_fetch_add(counter, 1, __ATOMIC_RELAXED);
+}
+
 static void jlgr_sprite_draw_to_pr__(jl_t *jl) {
 	jl_sprite_t *sprite = jl_mem_temp(jl, NULL);
 
@@ -22,7 +38,7 @@ static void jlgr_sprite_redraw_tex__(jlgr_t* jlgr, jl_sprite_t *spr) {
 // Redraw a sprite
 static inline void jlgr_sprite_redraw__(jlgr_t* jlgr, jl_sprite_t *spr) {
 	// If pre-renderer hasn't been intialized, initialize & redraw.
-	if(!spr->pr) jlgr_sprite_resize(jlgr, spr, NULL);
+	if(!spr->pr) jlgr_sprite_resize(jlgr, spr);
 	// Else, Redraw texture.
 	else jlgr_sprite_redraw_tex__(jlgr, spr);
 }
@@ -40,16 +56,15 @@ static inline void jlgr_sprite_redraw__(jlgr_t* jlgr, jl_sprite_t *spr) {
 void jlgr_sprite_dont(jl_t* jl, jl_sprite_t* sprite) { }
 
 /**
- * THREAD: Main thread only.
+ * THREAD: Any thread.
  * Run a sprite's draw routine to draw on it's pre-rendered texture.
  *
  * @param jl: The library context
  * @param spr: Which sprite to draw.
 **/
 void jlgr_sprite_redraw(jlgr_t* jlgr, jl_sprite_t *spr) {
-	jl_thread_mutex_lock(jlgr->jl, spr->mutex);
-	spr->update = 1;
-	jl_thread_mutex_unlock(jlgr->jl, spr->mutex);
+	SDL_AtomicSet(&spr->update, 1);
+	jlgr_sprite_count__(&jlgr_sprite_stats__.main);
 }
 
 /**
@@ -60,75 +75,93 @@ void jlgr_sprite_redraw(jlgr_t* jlgr, jl_sprite_t *spr) {
  * @param spr: The sprite.
 **/
 void jlgr_sprite_draw(jlgr_t* jlgr, jl_sprite_t *spr) {
-	jl_thread_mutex_lock(jlgr->jl, spr->mutex);
-
+	jl_sprite_state_t state = jlgr_sprite_state(spr);
 	jl_pr_t *pr = spr->pr;
 
 	if(!pr) {
 		jl_print(jlgr->jl, "jlgr_sprite_drw: not init'd!"); exit(-1);
 	}
-	// Redraw if needed.
-	if(spr->update) jlgr_sprite_redraw__(jlgr, spr);
-	spr->update = 0;
+	// Resize if the main thread changed the size, else redraw if needed.
+	if(state.rw != spr->prw || state.rh != spr->prh) {
+		SDL_AtomicSet(&spr->update, 0);
+		jlgr_sprite_resize(jlgr, spr);
+	}else if(SDL_AtomicSet(&spr->update, 0)) {
+		jlgr_sprite_redraw__(jlgr, spr);
+	}
 
-	jl_gl_transform_pr_(jlgr, pr, spr->cb.x, spr->cb.y, 0.,
+	jl_gl_transform_pr_(jlgr, pr, state.cb.x, state.cb.y, 0.,
 		1., 1., 1.);
 
 	jl_gl_draw_pr_(jlgr->jl, pr);
-	//
-	jl_thread_mutex_unlock(jlgr->jl, spr->mutex);
+	jlgr_sprite_count__(&jlgr_sprite_stats__.draw);
 }
 
 /**
  * THREAD: Draw thread only.
- * Resize a sprite to the current window - and redraw.
+ * Resize a sprite to the current window - and redraw.  To change the sprite's
+ * size, use jlgr_sprite_setrect() on the main thread.
  * @param jlgr: The library context.
  * @param spr: The sprite to use.
 **/
-void jlgr_sprite_resize(jlgr_t* jlgr, jl_sprite_t *spr, jl_rect_t* rc) {
-	u16_t res = (jlgr->gl.cp ? jlgr->gl.cp->w : jlgr->wm.w)
-		* spr->rw;
-
-	jl_thread_mutex_lock(jlgr->jl, spr->mutex);
-	// 
-	if(rc) {
-		// Set collision box.
-		spr->cb.x = rc->x; spr->cb.y = rc->y;
-		spr->cb.w = rc->w; spr->cb.h = rc->h;
-		// Set real dimensions
-		spr->rw = rc->w;
-		spr->rh = rc->h;
-	}
+void jlgr_sprite_resize(jlgr_t* jlgr, jl_sprite_t *spr) {
+	jl_sprite_state_t state = jlgr_sprite_state(spr);
+	m_u16_t res;
+
+	spr->prw = state.rw;
+	spr->prh = state.rh;
+	res = (jlgr->gl.cp ? jlgr->gl.cp->w : jlgr->wm.w) * state.rw;
 	// Initialize or Resize
 	if(jl_gl_pr_isi_(jlgr, spr->pr)) {
-		jl_gl_pr_rsz(jlgr,spr->pr,spr->rw,spr->rh,res);
+		jl_gl_pr_rsz(jlgr,spr->pr,state.rw,state.rh,res);
 	}else{
 		spr->pr = jl_gl_pr_new(jlgr,
-			spr->rw, spr->rh, res);
+			state.rw, state.rh, res);
 	}
 	// Redraw
 	jlgr_sprite_redraw_tex__(jlgr, spr);
-	//
-	jl_thread_mutex_unlock(jlgr->jl, spr->mutex);
+	jlgr_sprite_count__(&jlgr_sprite_stats__.draw);
+}
+
+/**
+ * THREAD: Main thread only.
+ * Set a sprite's collision box & size, & publish them.  The draw thread
+ * resizes the sprite's pre-renderer the next time it draws it.
+ * @param jlgr: The library context.
+ * @param spr: The sprite.
+ * @param rc: The rectangle bounding box & pr size.
+**/
+void jlgr_sprite_setrect(jlgr_t* jlgr, jl_sprite_t *spr, jl_rect_t rc) {
+	// Set collision box.
+	spr->cb.x = rc.x; spr->cb.y = rc.y;
+	spr->cb.w = rc.w; spr->cb.h = rc.h;
+	// Set real dimensions
+	spr->rw = rc.w;
+	spr->rh = rc.h;
+	jlgr_sprite_publish(jlgr, spr);
+	jlgr_sprite_count__(&jlgr_sprite_stats__.main);
 }
 
 /**
  * THREAD: Main thread only.
- * Run a sprite's loop.
+ * Run a sprite's loop, then publish any changes it made to the sprite.
  * @param jl: The library context.
  * @param spr: Which sprite to loop.
 **/
 void jlgr_sprite_loop(jlgr_t* jlgr, jl_sprite_t *spr) {
-	jl_thread_mutex_lock(jlgr->jl, spr->mutex);
 	jl_print_function(jlgr->jl, "Sprite/Loop");
 	((jlgr_sprite_fnt)spr->loop)(jlgr->jl, spr);
 	jl_print_return(jlgr->jl, "Sprite/Loop");
-	jl_thread_mutex_unlock(jlgr->jl, spr->mutex);
+	jlgr_sprite_publish(jlgr, spr);
+	jlgr_sprite_count__(&jlgr_sprite_stats__.main);
 }
 
 /**
  * THREAD: Main thread only.
- * Create a new sprite.
+ * Create a new sprite.  The loop runs on the main thread & the draw function
+ * on the draw thread, at the same time, with no lock between them.  Only
+ * "cb", "rh" & "rw" are handed over safely ( see jlgr_sprite_publish() ); if
+ * both use the sprite's context, they must synchronize it themselves ( ex:
+ * with SDL_atomic_t flags ).
  *
  * @param jl: The library context.
  * @param rc: The rectangle bounding box & pr size.
@@ -144,7 +177,7 @@ jl_sprite_t * jlgr_sprite_new(jlgr_t* jlgr, jl_rect_t rc,
 {
 	jl_sprite_t *spr = NULL;
 
-	spr = malloc(sizeof(jl_sprite_t));
+	spr = jl_mem__(jlgr->jl, NULL, sizeof(jl_sprite_t), JL_MEM_TAG_GL);
 	// Set collision box.
 	spr->cb.x = rc.x; spr->cb.y = rc.y;
 	spr->cb.w = rc.w; spr->cb.h = rc.h;
@@ -157,11 +190,15 @@ jl_sprite_t * jlgr_sprite_new(jlgr_t* jlgr, jl_rect_t rc,
 	spr->loop = loop;
 	// No pre-renderer made yet.
 	spr->pr = NULL;
-	// Make mutex
-	spr->mutex = jl_thread_mutex_new(jlgr->jl);
+	spr->prw = spr->prh = 0.f;
+	SDL_AtomicSet(&spr->update, 0);
+	// Publish the first state.
+	SDL_AtomicSet(&spr->seq, 0);
+	spr->lock = 0;
+	jlgr_sprite_publish(jlgr, spr);
 	// Allocate context
-	if(ctxs) spr->ctx = malloc(ctxs);
-	return spr; 
+	if(ctxs) spr->ctx = jl_mem(jlgr->jl, NULL, ctxs);
+	return spr;
 }
 
 /**
@@ -192,3 +229,57 @@ u8_t jlgr_sprite_collide(jlgr_t* jlgr,
 void* jlgr_sprite_getcontext(jl_sprite_t *sprite1) {
 	return sprite1->ctx;
 }
+
+/**
+ * THREAD: Any thread.
+ * Make changes to a sprite's "cb", "rh" & "rw" visible to the draw thread.
+ * jlgr_sprite_loop() does this after the sprite's loop.
+ * @param jlgr: The library context.
+ * @param spr: The sprite.
+**/
+void jlgr_sprite_publish(jlgr_t* jlgr, jl_sprite_t *spr) {
+	// Only publishers lock, & only against each other.
+	SDL_AtomicLock(&spr->lock);
+	SDL_AtomicAdd(&spr->seq, 1);
+	spr->state.cb = spr->cb;
+	spr->state.rh = spr->rh;
+	spr->state.rw = spr->rw;
+	SDL_AtomicAdd(&spr->seq, 1);
+	SDL_AtomicUnlock(&spr->lock);
+}
+
+/**
+ * THREAD: Any thread.
+ * Get the last published "cb", "rh" & "rw" of a sprite, without locking.
+ * @param spr: The sprite.
+ * @returns: A consistent copy.
+**/
+jl_sprite_state_t jlgr_sprite_state(jl_sprite_t *spr) {
+	jl_sprite_state_t state;
+	m_i32_t seq;
+
+	while(1) {
+		seq = SDL_AtomicGet(&spr->seq);
+		if(!(seq & 1)) {
+			state = spr->state;
+			// Nothing was published while copying.
+			if(SDL_AtomicGet(&spr->seq) == seq) return state;
+		}
+		jlgr_sprite_count__(&jlgr_sprite_stats__.retries);
+	}
+}
+
+/**
+ * THREAD: Any thread.
+ * Get how often sprites were used without a lock ( each would have locked a
+ * mutex before ), & how often a read had to retry because it raced a publish.
+ * @param jlgr: The library context.
+ * @param unlocked: Set to the # of sprite accesses that didn't lock.
+ * @param retries: Set to the # of reads that were retried.
+**/
+void jlgr_sprite_stats(jlgr_t* jlgr, m_u64_t* unlocked, m_u64_t* retries) {
+	*unlocked = __atomic_load_n(&jlgr_sprite_stats__.main, __ATOMIC_RELAXED)
+		+ __atomic_load_n(&jlgr_sprite_stats__.draw, __ATOMIC_RELAXED);
+	*retries = __atomic_load_n(&jlgr_sprite_stats__.retries,
+		__ATOMIC_RELAXED);
+}
@@ -22,10 +22,10 @@ static void jlgr_thread_resize(jlgr_t* jlgr, u16_t w, u16_t h) {
 
 		//Menu Bar
 		ctx->redraw = 2;
-		jlgr_sprite_resize(jlgr, jlgr->menubar.menubar, NULL);
+		jlgr_sprite_resize(jlgr, jlgr->menubar.menubar);
 	}
 	// Mouse resize
-	if(jlgr->mouse) jlgr_sprite_resize(jlgr, jlgr->mouse, NULL );
+	if(jlgr->mouse) jlgr_sprite_resize(jlgr, jlgr->mouse);
 	// Program's Resize
 	jl_fnct resize_ = jlgr->draw.redraw.resize;
 	resize_(jlgr->jl);
@@ -91,11 +91,11 @@ static void jlgr_thread_resize_event(jl_t* jl, void* data) {
 	}
 }
 
-static u8_t jlgr_thread_draw_event__(jl_t* jl) {
+static u8_t jlgr_thread_draw_event__(jl_t* jl, m_u32_t* count) {
 	jlgr_t* jlgr = jl->jlgr;
 	jlgr->draw.rtn = 0;
 
-	jl_thread_comm_recv(jl, jlgr->comm2draw, jlgr_thread_event);
+	*count = jl_thread_comm_recv(jl, jlgr->comm2draw, jlgr_thread_event);
 	return jlgr->draw.rtn;
 }
 
@@ -109,6 +109,7 @@ static void jlgr_thread_draw_init__(jl_t* jl) {
 	JL_PRINT_DEBUG(jl, "Resize Adjust");
 	jlgr->draw.rtn = 0;
 	while(jlgr->draw.rtn != 2) {
+		jl_thread_comm_wait(jl, jlgr->comm2draw, SDL_MUTEX_MAXWAIT);
 		jl_thread_comm_recv(jl, jlgr->comm2draw,
 			jlgr_thread_resize_event);
 	}
@@ -135,19 +136,53 @@ void jlgr_thread_send(jlgr_t* jlgr, u8_t id, u16_t x, u16_t y, jl_fnct fn) {
 	jlgr_thread_packet_t packet = { id, x, y, fn };
 
 	// Send resize packet.
-	jl_thread_comm_send(jlgr->jl, jlgr->comm2draw, &packet);
+	jlgr_thread_push__(jlgr, &packet, sizeof(packet));
+}
+
+/**
+ * THREAD: Main thread.
+ * Send a packet to the draw thread.  If the draw thread is behind & it's queue
+ * is full, wait for it to catch up.
+ * @param jlgr: The library context.
+ * @param packet: A jlgr_thread_packet_t or jlgr_comm_notify_t.
+ * @param size: The size of "packet".
+**/
+void jlgr_thread_push__(jlgr_t* jlgr, const void* packet, u32_t size) {
+	jlgr_comm_t comm;
+
+	jl_mem_copyto(packet, &comm, size);
+	while(!jl_thread_comm_send(jlgr->jl, jlgr->comm2draw, &comm))
+		SDL_Delay(1);
 }
 
 int jlgr_thread_draw(void* data) {
 	jl_t* jl = data;
 	jlgr_t* jlgr = jl->jlgr;
 
+	m_u32_t frame, count;
+
 	// Initialize subsystems
 	jl_thread_mutex_use(jl, jlgr->mutex, jlgr_thread_draw_init__);
+	// Own CPU, once the GL driver's threads are made ( they'd start with
+	// this thread's CPUs ).
+	jl_thread_pin(jl, jl_thread_cpus(jl, JL_THREAD_DRAW));
+	frame = SDL_GetTicks();
 	// Redraw loop
 	while(1) {
+		u32_t passed = SDL_GetTicks() - frame;
+		u8_t ondemand = SDL_AtomicGet(&jlgr->draw.ondemand);
+
+		// Sleep until there's a packet, a redraw request or the next
+		// frame is due ( on-demand drawing has no next frame ).
+		jl_thread_comm_wait(jl, jlgr->comm2draw, ondemand ?
+			SDL_MUTEX_MAXWAIT : passed < JLGR_FRAME_MS ?
+			JLGR_FRAME_MS - passed : 0);
 		// Check for events.
-		if(jlgr_thread_draw_event__(jl)) break;
+		if(jlgr_thread_draw_event__(jl, &count)) break;
+		// On-demand, only redraw if something changed.
+		if(ondemand && !count &&
+			!SDL_AtomicSet(&jlgr->draw.request, 0)) continue;
+		frame = SDL_GetTicks();
 		// Deselect any pre-renderer.
 		jlgr->gl.cp = NULL;
 		//Redraw screen.
@@ -162,8 +197,12 @@ int jlgr_thread_draw(void* data) {
 }
 
 void jlgr_thread_init(jlgr_t* jlgr) {
-	jlgr->thread = jl_thread_new(jlgr->jl, "JL_Lib/Graphics",
-		jlgr_thread_draw);
+	jl_thread_opt_t opt = { 0, -5 };
+
+	// Above workers, so frames aren't held up by other work ( it pins
+	// itself to it's own CPU after start up ).
+	jlgr->thread = jl_thread_new_opt(jlgr->jl, "JL_Lib/Graphics",
+		jlgr_thread_draw, &opt);
 }
 
 void jlgr_thread_kill(jlgr_t* jlgr) {
@@ -122,45 +122,31 @@ data_t* jl_vi_make_jpeg_(jl_t* jl,i32_t quality,m_u8_t* pxdata,u16_t w,u16_t h)
 /**
  * Load an image from data.
  * @param jl: The library context.
- * @param data: The data to read.
+ * @param data: The data to read from it's cursor ( borrowed, decoded in
+ *	place ).
  * @param w: Pointer to the width variable.
  * @param h: Pointer to the height variable.
  * @returns: Raw pixel data.
 **/
-m_u8_t* jl_vi_load_(jl_t* jl, data_t* data, m_u16_t* w, m_u16_t* h) {
+m_u8_t* jl_vi_load_(jl_t* jl, jl_view_t data, m_u16_t* w, m_u16_t* h) {
 	SDL_Surface *image; //  Free'd by SDL_free(image);
 	SDL_RWops *rw; // Free'd by SDL_RWFromMem
-	void* img_file; // Free'd by jl_mem
-	data_t* pixel_data; // Free'd by jl_mem_string_fstrt
-	void* rtn_pixels; // Returned so not free'd.
-	uint32_t color = 0;
-	u32_t FSIZE = data->size;
-	int i, j;
+	m_u8_t* rtn_pixels; // Returned so not free'd.
 	u32_t rgba = 3;
 
-//	memtester(jl, "LoadImg/Start0");
-	img_file = jl_memi(jl, FSIZE);
-//	memtester(jl, "LoadImg/Start1");
-	jl_data_loadto(data, FSIZE, img_file);
-//	memtester(jl, "LoadImg/Start2");
-	rw = SDL_RWFromMem(img_file, FSIZE);
-//	memtester(jl, "LoadImg/Start3");
+	// Decode straight from "data" at it's cursor ( no copy ).
+	if(data.curs > data.size) data.curs = data.size;
+	rw = SDL_RWFromConstMem(data.data + data.curs, data.size - data.curs);
 	if ((image = IMG_Load_RW(rw, 0)) == NULL) {
 		jl_print(jl, "Couldn't load image: %s", IMG_GetError());
 		jl_sg_kill(jl);
 	}
 //	memtester(jl, "LoadImg/Start4");
-	// Covert SDL_Surface.
-	pixel_data = jl_data_make(image->w * image->h * rgba);
-	for(i = 0; i < image->h; i++) {
-		for(j = 0; j < image->w; j++) {
-			color = _jl_sg_gpix(image, j, i);
-			jl_data_saveto(pixel_data, rgba, &color);
-		}
-	}
+	// Covert SDL_Surface ( into aligned memory, for SIMD kernels ).
+	rtn_pixels = jl_mem_aligned__(jl, image->w * image->h * rgba,
+		JL_MEM_ALIGN, JL_MEM_TAG_USER);
+	jl_sg_pixels__(jl, image, rtn_pixels, rgba);
 //	memtester(jl, "LoadImg/Start5");
-	//Set Return values
-	rtn_pixels = jl_data_tostring(jl, pixel_data);
 //	memtester(jl, "LoadImg/End6");
 	*w = image->w;
 	*h = image->h;
@@ -169,7 +155,5 @@ m_u8_t* jl_vi_load_(jl_t* jl, data_t* data, m_u16_t* w, m_u16_t* h) {
 //	memtester(jl, "LoadImg/End4");
 	SDL_free(rw);
 //	memtester(jl, "LoadImg/End3");
-	jl_mem(jl, &img_file, 0);
-//	memtester(jl, "LoadImg/End1");
 	return rtn_pixels;
 }
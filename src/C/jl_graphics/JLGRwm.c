@@ -97,7 +97,8 @@ void jl_wm_updatewh_(jlgr_t* jlgr) {
 //This is the code that actually creates the window by accessing SDL
 static inline void jlgr_wm_create__(jlgr_t* jlgr, u32_t w, u32_t h) {
 	// Allocate space for "displayWindow"
-	jlgr->wm.displayWindow = jl_memi(jlgr->jl, sizeof(jl_window_t));
+	jlgr->wm.displayWindow = jl_memi__(jlgr->jl, sizeof(jl_window_t),
+		JL_MEM_TAG_GL);
 	//
 	SDL_GL_SetAttribute(SDL_GL_RED_SIZE, 8);
 	SDL_GL_SetAttribute(SDL_GL_GREEN_SIZE, 8);
@@ -132,6 +133,8 @@ void jl_dl_loop__(jlgr_t* jlgr) {
 	newtick = SDL_GetTicks();
 	// milliseconds / 1000 to get seconds
 	jlgr->psec = ((double)(newtick - oldtick)) / 1000.;
+	// Release the draw thread's scratch memory for this frame.
+	jl_mem_frame_reset(jlgr->jl);
 
 //JL_PRINT("GR %f, N %f\n", 1./jlgr->psec, 1./jlgr->jl->time.psec);
 }